@@ -5,24 +5,430 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
 #include <sys/time.h>
+#include <omp.h>
 
-// Número de Threads (2 ou 4)
+// Número padrão de threads (alterado por -t ou pela variável OMP_NUM_THREADS)
 #define N_THREADS 4
 
+// Tamanho da linha de cache usada para separar os contadores das threads
+#define TAM_LINHA_CACHE 64
+
+// Tipo da contagem de soluções: 64 bits representa N <= 27
+// Compilando com -DCONTAGEM_128 a contagem passa a usar 128 bits
+#ifdef CONTAGEM_128
+typedef unsigned __int128 contagem_t;
+#else
+typedef unsigned long long contagem_t;
+#endif
+
+// Motores de contagem disponíveis
+#define MOTOR_ORIGINAL 0      // Varredura do tabuleiro com isSafe
+#define MOTOR_BITS 1          // Linhas e diagonais ocupadas em máscaras de bits
+#define MOTOR_ITER 2          // Motor de bits com pilha explícita no lugar da recursão
+
+// Modos de redução por simetria
+#define SIMETRIA_NENHUMA 0    // Percorre a árvore inteira
+#define SIMETRIA_ESPELHO 1    // Explora metade da primeira coluna e dobra a contagem
+#define SIMETRIA_CLASSES 2    // Classifica as soluções pelo grupo de rotações e reflexões
+
+// Tamanho máximo do tabuleiro no motor de bits (uma palavra de 64 bits)
+#define MAX_TAM_BITS 64
+
+// Tamanho máximo do tabuleiro copiado por valor para as tarefas
+#define MAX_TAM_TABULEIRO 64
+
+// Faixa de N com motor de bits especializado em tempo de compilação (máscaras de 32 bits)
+#define MIN_TAM_ESPECIALIZADO 4
+#define MAX_TAM_ESPECIALIZADO 32
+
+// Tamanho do buffer de cada thread na saída binária de soluções (descarregado em blocos)
+#define TAM_BUFFER_SAIDA (1 << 20)
+
+// Memoização das subárvores finais do motor de bits
+#define MEMO_MB_PADRAO 64     // Memória padrão das tabelas em MB (dividida entre as threads)
+#define MEMO_RESTANTES_MIN 3  // Com menos colunas restantes recontar é mais barato que consultar
+
+// A memoização é experimental e só existe em builds com -DMEMOIZACAO
+// Medida em N=14 e 15, qualquer janela fica mais lenta que o motor de bits sem tabela:
+// perto das folhas a consulta custa mais que recontar e longe delas os estados quase não se repetem
+#ifdef MEMOIZACAO
+#define USO_MEMO " [-M max[:min] [-H MB]]"
+#else
+#define USO_MEMO ""
+#endif
+
+// Tabuleiro de tamanho fixo, copiado junto da tarefa em vez de alocado no heap
+typedef struct{
+    int pos[MAX_TAM_TABULEIRO]; // Linha da dama em cada coluna
+} Tabuleiro;
+
+// Estado da busca com classificação por simetrias (motor de bits)
+// Cada solução fundamental possui 2, 4 ou 8 variantes distintas no grupo D4
+typedef struct{
+    uint64_t board[MAX_TAM_BITS]; // Bit da linha ocupada em cada coluna
+    uint64_t sidemask;            // Linhas das bordas (primeira e última)
+    uint64_t lastmask;            // Linhas proibidas na última coluna
+    uint64_t topbit;              // Bit da última linha
+    uint64_t endbit;              // Linha exigida na última coluna para simetria de 180 graus
+    int bound1, bound2;           // Coluna da primeira dama e sua espelhada
+    contagem_t count2, count4, count8; // Soluções fundamentais por tamanho de classe
+} BuscaSimetria;
+
+// Estado de uma coluna na pilha explícita do motor iterativo
+typedef struct{
+    uint64_t linhas, diag1, diag2; // Máscaras ocupadas ao chegar na coluna
+    uint64_t livres;              // Linhas candidatas ainda não exploradas na coluna
+} NivelPilha;
+
+// Entrada da tabela de memoização: contagem da subárvore a partir de um estado
+// O número de colunas restantes é implícito nas linhas ocupadas
+typedef struct{
+    uint64_t linhas;              // Linhas ocupadas (0 = entrada vazia)
+    uint64_t diag1, diag2;        // Diagonais que ainda atingem linhas livres
+    contagem_t contagem;          // Soluções da subárvore
+} EntradaMemo;
+
+// Tabela de memoização privada de cada thread
+// Cada subárvore é contada inteira por uma única tarefa, sem sincronização na tabela
+typedef struct{
+    EntradaMemo *entradas;        // Endereçamento direto pelo hash do estado
+    long long acertos;            // Consultas encontradas na tabela
+    long long falhas;             // Consultas recalculadas e gravadas na tabela
+} __attribute__((aligned(TAM_LINHA_CACHE))) TabelaMemo;
+
+// Configuração inicial do modo de completamento
+// As damas fixas podem estar em quaisquer colunas, não apenas em um prefixo
+typedef struct{
+    int valida;                       // Formato correto e damas fixas sem ataques entre si
+    int fixa[MAX_TAM_BITS];           // Linha da dama fixada em cada coluna (-1 = coluna livre)
+    uint64_t proibidas[MAX_TAM_BITS]; // Linhas atacadas pelas damas fixas em cada coluna
+} Configuracao;
+
+// Cabeçalho do arquivo binário de soluções
+// Cada solução segue como N índices de linha (coluna 0 primeiro) com bitsPorLinha
+// bits cada, empacotados a partir do bit menos significativo e completados até o byte
+typedef struct{
+    char magica[4];               // "NDSO"
+    uint32_t tamanho;             // N do tabuleiro
+    uint32_t bitsPorLinha;        // Bits usados por índice de linha
+} CabecalhoSolucoes;
+
+// Buffer privado de cada thread na saída binária de soluções
+typedef struct{
+    unsigned char *buffer;        // Soluções empacotadas aguardando escrita
+    size_t usado;                 // Bytes ocupados no buffer
+} __attribute__((aligned(TAM_LINHA_CACHE))) EscritorSolucoes;
+
+// Unidade de trabalho do modo checkpoint: prefixo válido das primeiras k colunas
+typedef struct{
+    uint64_t linhas, diag1, diag2; // Máscaras ocupadas ao final do prefixo
+} Prefixo;
+
+// Cabeçalho do arquivo de checkpoint (identifica a execução a ser retomada)
+typedef struct{
+    char magica[4];               // "NDCK"
+    uint32_t tamanho;             // N do tabuleiro
+    uint32_t prefixo;             // Colunas fixadas em cada unidade (k)
+    uint32_t simetria;            // Modo de simetria da execução
+    uint64_t unidades;            // Total de unidades de trabalho
+} CabecalhoCheckpoint;
+
+// Registro gravado ao concluir uma unidade (12 bytes)
+typedef struct{
+    uint32_t indice;              // Posição da unidade na enumeração dos prefixos
+    uint64_t contagem;            // Soluções encontradas na subárvore da unidade
+} __attribute__((packed)) RegistroCheckpoint;
+
+// Conexão de um trabalhador no modo coordenador
+typedef struct{
+    int fd;                       // Socket da conexão (-1 se livre)
+    int identificado;             // Trabalhador confirmou o mesmo N do coordenador
+    long long unidade;            // Unidade em processamento (-1 se ocioso)
+    char buffer[256];             // Linha parcial recebida
+    int usado;                    // Bytes ocupados no buffer
+} Trabalhador;
+
+// Contadores privados de cada thread, um por linha de cache
+// As folhas escrevem apenas no contador da própria thread; a soma ocorre ao final
+typedef struct{
+    contagem_t solucoes;          // Soluções encontradas pela thread
+    contagem_t fundamentais;      // Soluções fundamentais (modo classes)
+} __attribute__((aligned(TAM_LINHA_CACHE))) ContadorThread;
+
+
+// Colunas iniciais que geram tarefas sem corte explícito (abaixo delas a busca é sequencial)
+// Tarefas em todas as colunas do motor original continuam disponíveis com -c N
+#define PROF_TAREFAS 2
+
+// Ajuste automático da profundidade de corte: prefixos mínimos por thread
+#define PREFIXOS_POR_THREAD 16
+
+// Escolha adaptativa da equipe: nós estimados que justificam cada thread adicional
+// Abaixo de NOS_POR_THREAD a busca inteira roda na thread principal, sem tarefas
+#define NOS_POR_THREAD 200000
+
+// Sondas aleatórias usadas na estimativa do tamanho da árvore
+#define SONDAS_ESTIMATIVA 256
+
+// Limite de tamanhos de tabuleiro em uma execução em lote
+#define MAX_LOTE 256
+
+// Limite de trabalhadores conectados ao coordenador
+#define MAX_TRABALHADORES 256
+
+// Tentativas de conexão de um trabalhador ao coordenador (uma por segundo)
+#define TENTATIVAS_CONEXAO 10
+
+// Reinícios de cada trabalhador local que termina com unidades pendentes
+#define REINICIOS_LOCAIS 3
+
+// Intervalo em que o coordenador confere os processos dos trabalhadores locais (ms)
+#define INTERVALO_LOCAIS_MS 1000
+
 // Variáveis globais
-static int nSolutions = 0;    // Contador para o total de soluções
-static int TamTabuleiro;      // Tamanho do tabuleiro
+static contagem_t nSolutions = 0; // Total de soluções (soma dos contadores das threads)
+static contagem_t nFundamentais = 0; // Total de soluções fundamentais (únicas)
+static ContadorThread *contadores; // Contadores privados de cada thread
+static int TamTabuleiro;          // Tamanho do tabuleiro
+static int nThreads = N_THREADS;  // Threads disponíveis (tamanho dos vetores privados)
+static int nEquipe = N_THREADS;   // Threads da equipe na busca principal (nEquipe <= nThreads)
+static uint64_t mascaraTabuleiro; // Máscara com os N bits de linha do tabuleiro
+static int simetria = SIMETRIA_NENHUMA; // Modo de redução por simetria
+static int profCorte;             // Colunas que geram tarefas (abaixo delas a busca é sequencial)
+static long long nTarefas = 0;    // Contador de tarefas criadas
+static long long nAlocacoes = 0;  // Contador de alocações no heap feitas pelo programa
+static long long nUnidades = 0;   // Unidades de trabalho do modo checkpoint
+static long long nRetomadas = 0;  // Unidades já concluídas em execuções anteriores
+static contagem_t contagemRetomada = 0; // Soluções das unidades já concluídas
+static Prefixo *prefixos = NULL;  // Unidades de trabalho (prefixos de k colunas)
+static char *concluida = NULL;    // Marca das unidades já concluídas
+static FILE *fpCheckpoint = NULL; // Checkpoint aberto para anexar unidades concluídas
+static FILE *fpSaida = NULL;      // Destino da saída binária de soluções (NULL = apenas contagem)
+static EscritorSolucoes *escritores; // Buffers privados das threads na saída binária
+static int bitsPorLinha;          // Bits por índice de linha na saída binária
+static int bytesPorSolucao;       // Bytes ocupados por solução na saída binária
+static long long nConexoes = 0;   // Trabalhadores aceitos pelo coordenador
+static long long nReenvios = 0;   // Unidades reenviadas após a queda de um trabalhador
+static contagem_t (*kernelContagem)(uint64_t, uint64_t, uint64_t); // Motor de bits usado nas subárvores
+static int folhaIterativa = 0;    // Subárvores contadas pelo motor iterativo (-m iter)
+static int memoMin = 0, memoMax = 0; // Colunas restantes em que a tabela é consultada (0 = desativada)
+static long memoMB = MEMO_MB_PADRAO; // Memória total das tabelas de memoização
+static TabelaMemo *tabelasMemo = NULL; // Tabelas de memoização das threads
+static uint64_t mascaraMemo;      // Entradas por tabela - 1 (potência de 2)
+
+// Instrumentação opcional da busca (compilar com -DINSTRUMENTACAO)
+// Sem a opção as macros não geram código e a busca não paga nenhum custo
+#ifdef INSTRUMENTACAO
+// Estatísticas privadas de cada thread, somadas apenas no relatório final
+typedef struct{
+    long long nos[MAX_TAM_TABULEIRO + 1];   // Nós avaliados por profundidade (damas colocadas)
+    long long podas[MAX_TAM_TABULEIRO + 1]; // Linhas livres descartadas por ataque em cada profundidade
+    long long tarefasCriadas;             // Tarefas criadas pela thread
+    long long tarefasExecutadas;          // Tarefas executadas pela thread
+    double ocupado;                       // Segundos executando tarefas
+    int aninhamento;                      // Tarefas em execução empilhadas na thread
+} __attribute__((aligned(TAM_LINHA_CACHE))) EstatisticasThread;
+
+static EstatisticasThread *estatisticas; // Estatísticas das threads
+
+#define INSTR_NOS(prof, n) (estatisticas[omp_get_thread_num()].nos[prof] += (n))
+#define INSTR_PODAS(prof, n) (estatisticas[omp_get_thread_num()].podas[prof] += (n))
+#define INSTR_TAREFA_CRIADA() (estatisticas[omp_get_thread_num()].tarefasCriadas++)
+#define INSTR_INICIO_TAREFA() double inicioTarefa = iniciarTarefaInstr()
+#define INSTR_FIM_TAREFA() encerrarTarefaInstr(inicioTarefa)
+#else
+#define INSTR_NOS(prof, n)
+#define INSTR_PODAS(prof, n)
+#define INSTR_TAREFA_CRIADA()
+#define INSTR_INICIO_TAREFA()
+#define INSTR_FIM_TAREFA()
+#endif
+
+// Registra um nó do motor de bits: a profundidade é o número de linhas ocupadas
+// e as podas são as linhas ainda livres mas atacadas por alguma diagonal
+#define INSTR_NO_BITS(linhas, diag1, diag2) \
+    INSTR_NOS(__builtin_popcountll(linhas), 1); \
+    INSTR_PODAS(__builtin_popcountll(linhas), __builtin_popcountll(~(linhas) & ((diag1) | (diag2)) & mascaraTabuleiro))
+
+// Aloca memória alinhada à linha de cache contabilizando as alocações da execução
+// Nenhuma alocação deve ocorrer por nó ou por tarefa, apenas na preparação
+void *alocar(size_t tamanho){
+    void *p = NULL;
+
+    #pragma omp atomic
+    nAlocacoes++;
+
+    if(posix_memalign(&p, TAM_LINHA_CACHE, tamanho) != 0){
+        fprintf(stdout, "Falha ao alocar %zu bytes\n", tamanho);
+        exit(-1);
+    }
+    return p;
+}
+
+// Aumenta um bloco obtido com alocar(), mantendo o alinhamento e a contagem de alocações
+void *realocar(void *antigo, size_t tamanhoAntigo, size_t tamanho){
+    void *p = alocar(tamanho);
+
+    if(antigo != NULL){
+        memcpy(p, antigo, tamanhoAntigo);
+        free(antigo);
+    }
+    return p;
+}
+
+#ifdef INSTRUMENTACAO
+// Marca o início de uma tarefa na thread e devolve o instante inicial
+// Uma tarefa executada dentro de outra (ponto de escalonamento) não é medida duas vezes
+double iniciarTarefaInstr(){
+    EstatisticasThread *e = &estatisticas[omp_get_thread_num()];
+
+    e->tarefasExecutadas++;
+    return (e->aninhamento++ == 0) ? omp_get_wtime() : 0.0;
+}
+
+// Acumula o tempo ocupado da thread ao encerrar a tarefa mais externa
+void encerrarTarefaInstr(double inicio){
+    EstatisticasThread *e = &estatisticas[omp_get_thread_num()];
+
+    if(--e->aninhamento == 0){
+        e->ocupado += omp_get_wtime() - inicio;
+    }
+}
+#endif
+
+// Converte uma contagem (64 ou 128 bits) para texto decimal
+char *formatarContagem(contagem_t valor, char *texto){
+    char inverso[48];
+    int n = 0;
+
+    do{
+        inverso[n++] = '0' + (int)(valor % 10);
+        valor /= 10;
+    }while(valor > 0);
+
+    for(int i = 0; i < n; i++){
+        texto[i] = inverso[n - 1 - i];
+    }
+    texto[n] = '\0';
+    return texto;
+}
+
+// Soma os contadores privados das threads nos totais globais
+void reduzirContadores(){
+    nSolutions = 0;
+    nFundamentais = 0;
+    for(int t = 0; t < nThreads; t++){
+        nSolutions += contadores[t].solucoes;
+        nFundamentais += contadores[t].fundamentais;
+    }
+}
 
 // Função que imprime uma solução encontrada
 void printSolution(int *board){
-    printf("Solução %d: ", nSolutions);
+    char texto[48];
+
+    printf("Solução %s: ", formatarContagem(contadores[omp_get_thread_num()].solucoes, texto));
     for(int col = 0; col < TamTabuleiro; col++){
         printf("(%d, %d) ", board[col], col);
     }
     printf("\n");
 }
 
+// Abre a saída binária de soluções e grava o cabeçalho ("-" usa a saída padrão)
+// Cada thread recebe seu próprio buffer, alocado uma única vez
+void abrirSaida(const char *arquivo){
+    CabecalhoSolucoes cab;
+
+    fpSaida = (strcmp(arquivo, "-") == 0) ? stdout : fopen(arquivo, "wb");
+    if(fpSaida == NULL){
+        perror("Erro ao abrir a saída de soluções");
+        exit(-1);
+    }
+    escritores = (EscritorSolucoes *)alocar(nThreads*sizeof(EscritorSolucoes));
+    for(int t = 0; t < nThreads; t++){
+        escritores[t].buffer = (unsigned char *)alocar(TAM_BUFFER_SAIDA);
+        escritores[t].usado = 0;
+    }
+
+    for(bitsPorLinha = 1; (1 << bitsPorLinha) < TamTabuleiro; bitsPorLinha++);
+    bytesPorSolucao = (TamTabuleiro * bitsPorLinha + 7) / 8;
+
+    memcpy(cab.magica, "NDSO", 4);
+    cab.tamanho = TamTabuleiro;
+    cab.bitsPorLinha = bitsPorLinha;
+    fwrite(&cab, sizeof(cab), 1, fpSaida);
+}
+
+// Descarrega o buffer de uma thread em um único bloco
+// Apenas a escrita do bloco é serializada entre as threads
+void descarregarSaida(EscritorSolucoes *e){
+    #pragma omp critical(saida)
+    fwrite(e->buffer, 1, e->usado, fpSaida);
+    e->usado = 0;
+}
+
+// Empacota uma solução (linha de cada coluna) no buffer da thread
+void empacotarSolucao(EscritorSolucoes *e, int *board, int espelhar){
+    unsigned char *destino;
+    uint64_t acumulador = 0;
+    int nBits = 0;
+
+    if(e->usado + bytesPorSolucao > TAM_BUFFER_SAIDA){
+        descarregarSaida(e);
+    }
+    destino = e->buffer + e->usado;
+    e->usado += bytesPorSolucao;
+
+    for(int col = 0; col < TamTabuleiro; col++){
+        uint64_t linha = espelhar ? TamTabuleiro - 1 - board[col] : board[col];
+
+        acumulador |= linha << nBits;
+        nBits += bitsPorLinha;
+        while(nBits >= 8){
+            *destino++ = acumulador & 0xFF;
+            acumulador >>= 8;
+            nBits -= 8;
+        }
+    }
+    if(nBits > 0){
+        *destino = acumulador & 0xFF;
+    }
+}
+
+// Grava uma solução encontrada; no modo espelho grava também sua reflexão
+void gravarSolucao(int *board){
+    EscritorSolucoes *e = &escritores[omp_get_thread_num()];
+
+    empacotarSolucao(e, board, 0);
+    if(simetria == SIMETRIA_ESPELHO && TamTabuleiro > 1){
+        empacotarSolucao(e, board, 1);
+    }
+}
+
+// Descarrega o restante dos buffers e fecha a saída binária
+void fecharSaida(){
+    for(int t = 0; t < nThreads; t++){
+        descarregarSaida(&escritores[t]);
+        free(escritores[t].buffer);
+    }
+    free(escritores);
+
+    if(fpSaida == stdout){
+        fflush(fpSaida);
+    }
+    else{
+        fclose(fpSaida);
+    }
+}
+
 // Confere se a posição da dama é válida (1) ou inválida (0) antes de colocá-la
 int isSafe(int *board, int row, int col){
     int i, j;
@@ -51,10 +457,70 @@ int isSafe(int *board, int row, int col){
     return 1;
 }
 
+// Retorna o limite de linhas a explorar em uma coluna
+// No modo espelho a primeira coluna usa apenas a metade superior; se a dama
+// estiver na linha central (N ímpar), a segunda coluna é que é dividida ao meio
+int limiteLinhas(int *board, int col){
+    int meio = TamTabuleiro / 2;
+
+    if(simetria == SIMETRIA_NENHUMA || TamTabuleiro == 1){
+        return TamTabuleiro;
+    }
+    if(col == 0){
+        return (TamTabuleiro + 1) / 2;
+    }
+    if(col == 1 && TamTabuleiro % 2 == 1 && board[0] == meio){
+        return meio;
+    }
+    return TamTabuleiro;
+}
+
+// Percorre sequencialmente a subárvore abaixo da profundidade de corte
+// O tabuleiro é reaproveitado: cada coluna sobrescreve apenas a sua posição
+contagem_t solveNQSequencial(int *board, int col){
+    int limite = limiteLinhas(board, col);
+    contagem_t total = 0;
+
+    INSTR_NOS(col, 1);
+
+    for(int i = 0; i < limite; i++){
+        if(isSafe(board, i, col)){
+            board[col] = i;
+
+            if(col == TamTabuleiro-1){
+                if(fpSaida != NULL){
+                    gravarSolucao(board);
+                }
+                total++;
+                INSTR_NOS(TamTabuleiro, 1);
+            }
+            else{
+                total += solveNQSequencial(board, col + 1);
+            }
+        }
+        else{
+            INSTR_PODAS(col, 1);
+        }
+    }
+    return total;
+}
+
 // Percorre o tabuleiro colocando as damas em posições válidas
 void solveNQ(int *board, int col){
-    // Lê os valores da coluna atual até o final do tabuleiro
-    for(int i = 0; i < TamTabuleiro; i++){
+    int limite = limiteLinhas(board, col);
+
+    // Abaixo da profundidade de corte a subárvore é resolvida sem novas tarefas
+    if(col >= profCorte){
+        contagem_t parcial = solveNQSequencial(board, col);
+
+        // Contabiliza as soluções da subárvore de uma só vez no contador da thread
+        contadores[omp_get_thread_num()].solucoes += parcial;
+        return;
+    }
+    INSTR_NOS(col, 1);
+
+    // Lê os valores da coluna atual até o limite de exploração
+    for(int i = 0; i < limite; i++){
         // Confere se uma posição é válida
         if(isSafe(board, i, col)){
             // Atribui a posição da dama no tabuleiro
@@ -62,76 +528,2025 @@ void solveNQ(int *board, int col){
       
             // Solução encontrada para a coluna atual
             if(col == TamTabuleiro-1){ 
-                #pragma omp critical
-                {
-                    // Exibe as coordenadas da solução encontrada
-                    //printSolution(board);
+                // Grava a solução no buffer da thread, sem seção crítica por solução
+                if(fpSaida != NULL){
+                    gravarSolucao(board);
                 }
                 
-                // Contabiliza a solução
-                #pragma omp atomic
-                nSolutions++;
+                // Contabiliza a solução no contador da thread
+                contadores[omp_get_thread_num()].solucoes++;
+                INSTR_NOS(TamTabuleiro, 1);
             }
             else{ 
-                // Copia o tabuleiro atual para um temporário
-                int *nb = (int *)malloc(TamTabuleiro*sizeof(int));
-                memcpy(nb, board, TamTabuleiro*sizeof(int));
+                // Copia as colunas preenchidas para um tabuleiro de tamanho fixo
+                // que segue por valor para a tarefa (sem malloc/free por nó)
+                Tabuleiro nb;
+                memcpy(nb.pos, board, (col + 1)*sizeof(int));
+
+                #pragma omp atomic
+                nTarefas++;
+                INSTR_TAREFA_CRIADA();
                 
                 // Segue para a próxima coluna
-                #pragma omp task
+                #pragma omp task firstprivate(nb)
                 {
-                    solveNQ(nb, col + 1);
-
-                    // Libera o tabuleiro temporário
-                    free(nb);
+                    INSTR_INICIO_TAREFA();
+                    solveNQ(nb.pos, col + 1);
+                    INSTR_FIM_TAREFA();
                 }
             }
         }
+        else{
+            INSTR_PODAS(col, 1);
+        }
     }
 }
  
-// Função principal que recebe N de entrada e resolve o problema medindo o tempo de cada execução
-int main(int argc, char *argv[]){
-    int i, *board;
-    struct timeval start, stop;
+// Conta as soluções guardando linhas e diagonais ocupadas como máscaras de bits
+// Cada bit livre em ~(linhas | diag1 | diag2) é uma linha válida na coluna atual
+// Versão sequencial executada dentro de uma única tarefa
+contagem_t solveNQBits(uint64_t linhas, uint64_t diag1, uint64_t diag2){
+    INSTR_NO_BITS(linhas, diag1, diag2);
 
-    // Verifica se o valor de N foi incluído na linha de comando
-    if(argc <=1){
-        fprintf(stdout, "É necessário especificar o tamanho do tabuleiro\n");
-        exit(-1);
+    // Todas as linhas ocupadas: solução encontrada
+    if(linhas == mascaraTabuleiro){
+        return 1;
     }
 
-    // Recebe o tamnho do tabuleiro com base na entrada (argv[1])
-    TamTabuleiro = strtol(argv[1], NULL, 10);
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
 
-    // Alocação dinâmica do tabuleiro
-    board = (int *)malloc(TamTabuleiro*sizeof(int));
+    while(livres){
+        // Extrai o bit menos significativo (linha livre de menor índice)
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
 
-    // Obtém o tempo inicial
-    gettimeofday(&start, NULL);
- 
-    // Resolve o problema das N-Damas coluna por coluna
-    #pragma omp parallel num_threads(N_THREADS)
-    {
-        #pragma omp single
+        // Segue para a próxima coluna deslocando as diagonais
+        total += solveNQBits(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1);
+    }
+    return total;
+}
+
+// Gera o motor de bits especializado para um N fixo em tempo de compilação
+// A máscara do tabuleiro vira constante e as máscaras usam 32 bits; a entrada de 64 bits
+// descarta apenas bits de diagonal que já saíram do tabuleiro
+#define DEFINIR_KERNEL(N) \
+contagem_t solveNQBits##N(uint32_t linhas, uint32_t diag1, uint32_t diag2, int restantes){ \
+    const uint32_t mascara = (uint32_t)((1ULL << N) - 1); \
+    uint32_t livres = ~(linhas | diag1 | diag2) & mascara; \
+    INSTR_NO_BITS(linhas, diag1, diag2); \
+    if(restantes == 1){ \
+        INSTR_NOS(N, livres != 0); \
+        return livres != 0; \
+    } \
+    contagem_t total = 0; \
+    while(livres){ \
+        uint32_t bit = livres & -livres; \
+        livres ^= bit; \
+        total += solveNQBits##N(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, restantes - 1); \
+    } \
+    return total; \
+} \
+contagem_t kernelContagem##N(uint64_t linhas, uint64_t diag1, uint64_t diag2){ \
+    if(linhas == (1ULL << N) - 1){ \
+        INSTR_NOS(N, 1); \
+        return 1; \
+    } \
+    return solveNQBits##N((uint32_t)linhas, (uint32_t)diag1, (uint32_t)diag2, N - __builtin_popcountll(linhas)); \
+}
+
+// Tamanhos com motor especializado (MIN_TAM_ESPECIALIZADO a MAX_TAM_ESPECIALIZADO)
+#define LISTA_KERNELS(X) \
+    X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) X(18) \
+    X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32)
+
+LISTA_KERNELS(DEFINIR_KERNEL)
+
+// Tabela de despacho indexada por N
+#define ENTRADA_KERNEL(N) [N] = kernelContagem##N,
+static contagem_t (*const kernelsEspecializados[MAX_TAM_ESPECIALIZADO + 1])(uint64_t, uint64_t, uint64_t) = {
+    LISTA_KERNELS(ENTRADA_KERNEL)
+};
+
+// Versão iterativa do motor de bits: cada coluna ocupa um nível de uma pilha explícita
+// A coluna atual fica em registradores; a pilha (32 bytes por coluna) cabe no cache L1
+// e só é acessada ao descer ou voltar uma coluna, sem chamada de função por nó
+// Medido contra a recursão em N=15 a 18 (ComparacaoMotores.sh) não é mais rápida:
+// 5% à frente em N=16 e de 5% a 13% atrás nos demais; fica como alternativa (-m iter)
+contagem_t solveNQIter(uint64_t linhas, uint64_t diag1, uint64_t diag2){
+    NivelPilha pilha[MAX_TAM_BITS];
+    contagem_t total = 0;
+    int topo = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    INSTR_NO_BITS(linhas, diag1, diag2);
+    if(linhas == mascaraTabuleiro){
+        return 1;
+    }
+
+    for(;;){
+        // Coluna esgotada: volta para a anterior
+        if(livres == 0){
+            if(topo == 0){
+                break;
+            }
+            topo--;
+            linhas = pilha[topo].linhas;
+            diag1 = pilha[topo].diag1;
+            diag2 = pilha[topo].diag2;
+            livres = pilha[topo].livres;
+            continue;
+        }
+
+        // Extrai o bit menos significativo (linha livre de menor índice)
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        uint64_t l = linhas | bit;
+        uint64_t d1 = (diag1 | bit) << 1;
+        uint64_t d2 = (diag2 | bit) >> 1;
+        INSTR_NO_BITS(l, d1, d2);
+
+        // Última coluna preenchida: conta a solução sem empilhar
+        if(l == mascaraTabuleiro){
+            total++;
+            continue;
+        }
+
+        // Desce apenas se a próxima coluna possuir alguma linha livre
+        uint64_t proximas = ~(l | d1 | d2) & mascaraTabuleiro;
+        if(proximas){
+            pilha[topo].linhas = linhas;
+            pilha[topo].diag1 = diag1;
+            pilha[topo].diag2 = diag2;
+            pilha[topo].livres = livres;
+            topo++;
+
+            linhas = l;
+            diag1 = d1;
+            diag2 = d2;
+            livres = proximas;
+        }
+    }
+    return total;
+}
+
+// Variante do motor de bits que guarda a linha de cada coluna e grava as soluções
+contagem_t solveNQBitsSaida(uint64_t linhas, uint64_t diag1, uint64_t diag2, int col, int *board){
+    INSTR_NO_BITS(linhas, diag1, diag2);
+
+    if(linhas == mascaraTabuleiro){
+        gravarSolucao(board);
+        return 1;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        // Índice da linha livre escolhida
+        board[col] = __builtin_ctzll(bit);
+        total += solveNQBitsSaida(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, col + 1, board);
+    }
+    return total;
+}
+
+// Aloca uma tabela de memoização por thread dividindo a memória configurada
+// Cada tabela recebe a maior potência de 2 de entradas que cabe na sua parte
+void iniciarMemo(){
+    size_t porThread = ((size_t)memoMB << 20) / nThreads, entradas = 1;
+
+    while(2 * entradas * sizeof(EntradaMemo) <= porThread){
+        entradas *= 2;
+    }
+    mascaraMemo = entradas - 1;
+
+    tabelasMemo = (TabelaMemo *)alocar(nThreads*sizeof(TabelaMemo));
+    for(int t = 0; t < nThreads; t++){
+        tabelasMemo[t].entradas = (EntradaMemo *)alocar(entradas*sizeof(EntradaMemo));
+        memset(tabelasMemo[t].entradas, 0, entradas*sizeof(EntradaMemo));
+        tabelasMemo[t].acertos = 0;
+        tabelasMemo[t].falhas = 0;
+    }
+}
+
+// Libera as tabelas de memoização
+void liberarMemo(){
+    for(int t = 0; t < nThreads; t++){
+        free(tabelasMemo[t].entradas);
+    }
+    free(tabelasMemo);
+}
+
+// Espalha o estado (linhas e diagonais) pelos bits do índice da tabela
+uint64_t hashEstado(uint64_t linhas, uint64_t diag1, uint64_t diag2){
+    uint64_t h = linhas * 0x9E3779B97F4A7C15ULL ^ diag1 * 0xC2B2AE3D27D4EB4FULL ^ diag2 * 0x165667B19E3779F9ULL;
+    return h ^ (h >> 31);
+}
+
+// Motor de bits com memoização das subárvores dentro da janela de colunas restantes
+// Bits de diagonal que só atingiriam linhas já ocupadas são descartados da chave,
+// de modo que prefixos diferentes com o mesmo futuro compartilhem a entrada
+contagem_t solveNQBitsMemo(TabelaMemo *tabela, uint64_t linhas, uint64_t diag1, uint64_t diag2, int restantes){
+    EntradaMemo *e = NULL;
+
+    // Abaixo da janela a subárvore é contada diretamente
+    if(restantes < memoMin){
+        return folhaIterativa ? solveNQIter(linhas, diag1, diag2) : kernelContagem(linhas, diag1, diag2);
+    }
+    INSTR_NO_BITS(linhas, diag1, diag2);
+
+    if(restantes <= memoMax){
+        uint64_t livresFuturas = ~linhas & mascaraTabuleiro, alcance1 = 0, alcance2 = 0;
+
+        // A diagonal na linha r atinge a linha r+k (ou r-k) k colunas adiante
+        for(int k = 0; k < restantes; k++){
+            alcance1 |= livresFuturas >> k;
+            alcance2 |= livresFuturas << k;
+        }
+        diag1 &= alcance1;
+        diag2 &= alcance2;
+
+        e = &tabela->entradas[hashEstado(linhas, diag1, diag2) & mascaraMemo];
+        if(e->linhas == linhas && e->diag1 == diag1 && e->diag2 == diag2){
+            tabela->acertos++;
+            return e->contagem;
+        }
+        tabela->falhas++;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        total += solveNQBitsMemo(tabela, linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, restantes - 1);
+    }
+
+    // Substitui a entrada anterior do mesmo índice
+    if(e != NULL){
+        e->linhas = linhas;
+        e->diag1 = diag1;
+        e->diag2 = diag2;
+        e->contagem = total;
+    }
+    return total;
+}
+
+// Conta a subárvore a partir de uma coluna, gravando as soluções se a saída estiver ativa
+contagem_t contarSubarvore(uint64_t linhas, uint64_t diag1, uint64_t diag2, int col, int *board){
+    if(fpSaida != NULL){
+        return solveNQBitsSaida(linhas, diag1, diag2, col, board);
+    }
+    if(tabelasMemo != NULL){
+        return solveNQBitsMemo(&tabelasMemo[omp_get_thread_num()], linhas, diag1, diag2, TamTabuleiro - col);
+    }
+    if(folhaIterativa){
+        return solveNQIter(linhas, diag1, diag2);
+    }
+    return kernelContagem(linhas, diag1, diag2);
+}
+
+// Distribui as primeiras colunas do motor de bits em tarefas
+// A partir da profundidade de corte cada tarefa conta sua subárvore sequencialmente
+// O tabuleiro só é lido quando a saída de soluções está ativa
+void solveNQBitsParalelo(uint64_t linhas, uint64_t diag1, uint64_t diag2, int col, int *board){
+    if(col >= profCorte || linhas == mascaraTabuleiro){
+        contagem_t parcial = contarSubarvore(linhas, diag1, diag2, col, board);
+
+        // Contabiliza as soluções da subárvore de uma só vez no contador da thread
+        contadores[omp_get_thread_num()].solucoes += parcial;
+        return;
+    }
+    INSTR_NO_BITS(linhas, diag1, diag2);
+
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        // Extrai o bit menos significativo (linha livre de menor índice)
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        // Tabuleiro de tamanho fixo levado por valor para a tarefa
+        Tabuleiro nb;
+        memcpy(nb.pos, board, col*sizeof(int));
+        nb.pos[col] = __builtin_ctzll(bit);
+
+        #pragma omp atomic
+        nTarefas++;
+        INSTR_TAREFA_CRIADA();
+
+        // Segue para a próxima coluna em uma nova tarefa
+        #pragma omp task firstprivate(linhas, diag1, diag2, bit, col, nb)
         {
-            // Resolve o problema das N-Damas percorrendo todas as colunas
-            solveNQ(board,0);
+            INSTR_INICIO_TAREFA();
+            solveNQBitsParalelo(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, col + 1, nb.pos);
+            INSTR_FIM_TAREFA();
         }
     }
-  
-    // Obtém o tempo final
-    gettimeofday(&stop, NULL); 
+}
 
-    // Cálculo do tempo gasto pelo processo
-    double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
+// Distribui em tarefas apenas a metade espelhada da árvore do motor de bits
+// Metade superior da primeira coluna; na linha central, metade superior da segunda
+// A contagem é dobrada ao final da região paralela
+void solveNQBitsEspelhoParalelo(){
+    int meio = TamTabuleiro / 2;
 
-    // Exibe o total de soluções e o tempo decorrido
-    fprintf(stdout, "Número total de soluções: %d\n", nSolutions); 
-    fprintf(stdout, "Tempo decorrido = %g ms\n", t);
+    for(int i = 0; i < meio; i++){
+        uint64_t bit = 1ULL << i;
+        Tabuleiro nb;
+        nb.pos[0] = i;
+
+        #pragma omp atomic
+        nTarefas++;
+        INSTR_TAREFA_CRIADA();
+
+        #pragma omp task firstprivate(bit, nb)
+        {
+            INSTR_INICIO_TAREFA();
+            solveNQBitsParalelo(bit, bit << 1, bit >> 1, 1, nb.pos);
+            INSTR_FIM_TAREFA();
+        }
+    }
+
+    // Linha central da primeira coluna (N ímpar)
+    if(TamTabuleiro % 2 == 1){
+        uint64_t centro = 1ULL << meio;
+        uint64_t diag1 = centro << 1, diag2 = centro >> 1;
+        uint64_t livres = ~(centro | diag1 | diag2) & ((1ULL << meio) - 1);
+
+        while(livres){
+            uint64_t bit = livres & -livres;
+            livres ^= bit;
+
+            Tabuleiro nb;
+            nb.pos[0] = meio;
+            nb.pos[1] = __builtin_ctzll(bit);
+
+            #pragma omp atomic
+            nTarefas++;
+            INSTR_TAREFA_CRIADA();
+
+            #pragma omp task firstprivate(bit, nb)
+            {
+                INSTR_INICIO_TAREFA();
+                solveNQBitsParalelo(centro | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, 2, nb.pos);
+                INSTR_FIM_TAREFA();
+            }
+        }
+    }
+}
+
+// Confere se a solução completa é a representante da sua classe de simetria
+// e a contabiliza conforme o número de variantes distintas (2, 4 ou 8)
+void checkSimetria(BuscaSimetria *s){
+    uint64_t *board = s->board;
+    int ultima = TamTabuleiro - 1;
+    int own, you;
+    uint64_t bit, ptn;
+
+    // Rotação de 90 graus
+    if(board[s->bound2] == 1){
+        for(ptn = 2, own = 1; own <= ultima; own++, ptn <<= 1){
+            bit = 1;
+            for(you = ultima; board[you] != ptn && board[own] >= bit; you--){
+                bit <<= 1;
+            }
+            if(board[own] > bit){
+                return;
+            }
+            if(board[own] < bit){
+                break;
+            }
+        }
+        // Solução igual à sua rotação de 90 graus
+        if(own > ultima){
+            s->count2++;
+            return;
+        }
+    }
+
+    // Rotação de 180 graus
+    if(board[ultima] == s->endbit){
+        for(you = ultima - 1, own = 1; own <= ultima; own++, you--){
+            bit = 1;
+            for(ptn = s->topbit; ptn != board[you] && board[own] >= bit; ptn >>= 1){
+                bit <<= 1;
+            }
+            if(board[own] > bit){
+                return;
+            }
+            if(board[own] < bit){
+                break;
+            }
+        }
+        // Solução igual à sua rotação de 180 graus
+        if(own > ultima){
+            s->count4++;
+            return;
+        }
+    }
+
+    // Rotação de 270 graus
+    if(board[s->bound1] == s->topbit){
+        for(ptn = s->topbit >> 1, own = 1; own <= ultima; own++, ptn >>= 1){
+            bit = 1;
+            for(you = 0; board[you] != ptn && board[own] >= bit; you++){
+                bit <<= 1;
+            }
+            if(board[own] > bit){
+                return;
+            }
+            if(board[own] < bit){
+                break;
+            }
+        }
+    }
+    s->count8++;
+}
+
+// Busca com a primeira dama no canto: nenhuma solução é simétrica a si mesma
+void backtrackCanto(BuscaSimetria *s, int col, uint64_t diag1, uint64_t linhas, uint64_t diag2){
+    uint64_t livres = mascaraTabuleiro & ~(diag1 | linhas | diag2);
+
+    INSTR_NO_BITS(linhas, diag1, diag2);
+    if(col == TamTabuleiro - 1){
+        if(livres){
+            INSTR_NOS(TamTabuleiro, 1);
+            s->board[col] = livres;
+            s->count8++;
+        }
+        return;
+    }
 
-    // Libera o tabuleiro
+    // Elimina a reflexão pela diagonal principal
+    if(col < s->bound1){
+        livres &= ~2ULL;
+    }
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        s->board[col] = bit;
+        backtrackCanto(s, col + 1, (diag1 | bit) << 1, linhas | bit, (diag2 | bit) >> 1);
+    }
+}
+
+// Busca com a primeira dama fora do canto, podando pelas bordas do tabuleiro
+void backtrackBorda(BuscaSimetria *s, int col, uint64_t diag1, uint64_t linhas, uint64_t diag2){
+    uint64_t livres = mascaraTabuleiro & ~(diag1 | linhas | diag2);
+
+    INSTR_NO_BITS(linhas, diag1, diag2);
+    if(col == TamTabuleiro - 1){
+        if(livres && !(livres & s->lastmask)){
+            INSTR_NOS(TamTabuleiro, 1);
+            s->board[col] = livres;
+            checkSimetria(s);
+        }
+        return;
+    }
+
+    if(col < s->bound1){
+        livres &= ~s->sidemask;
+    }
+    else if(col == s->bound2){
+        if(!(linhas & s->sidemask)){
+            return;
+        }
+        if((linhas & s->sidemask) != s->sidemask){
+            livres &= s->sidemask;
+        }
+    }
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        s->board[col] = bit;
+        backtrackBorda(s, col + 1, (diag1 | bit) << 1, linhas | bit, (diag2 | bit) >> 1);
+    }
+}
+
+// Contabiliza as classes encontradas por uma tarefa
+void contabilizarSimetria(BuscaSimetria *s){
+    ContadorThread *c = &contadores[omp_get_thread_num()];
+
+    c->solucoes += 2 * s->count2 + 4 * s->count4 + 8 * s->count8;
+    c->fundamentais += s->count2 + s->count4 + s->count8;
+}
+
+// Conta as soluções pelas classes de simetria do grupo D4
+// Total = 2*count2 + 4*count4 + 8*count8 e fundamentais = count2 + count4 + count8
+// Cada tarefa recebe uma cópia própria do estado da busca
+void solveNQClassesParalelo(){
+    BuscaSimetria s;
+    uint64_t bit;
+    int ultima = TamTabuleiro - 1;
+
+    memset(&s, 0, sizeof(s));
+    s.topbit = 1ULL << ultima;
+
+    // Primeira dama no canto: uma tarefa por linha da segunda coluna
+    s.board[0] = 1;
+    for(s.bound1 = 2; s.bound1 < ultima; s.bound1++){
+        s.board[1] = bit = 1ULL << s.bound1;
+
+        #pragma omp atomic
+        nTarefas++;
+        INSTR_TAREFA_CRIADA();
+
+        #pragma omp task firstprivate(s, bit)
+        {
+            INSTR_INICIO_TAREFA();
+            backtrackCanto(&s, 2, (2 | bit) << 1, 1 | bit, bit >> 1);
+            contabilizarSimetria(&s);
+            INSTR_FIM_TAREFA();
+        }
+    }
+
+    // Primeira dama fora do canto: uma tarefa por linha da segunda coluna
+    s.sidemask = s.lastmask = s.topbit | 1;
+    s.endbit = s.topbit >> 1;
+    for(s.bound1 = 1, s.bound2 = TamTabuleiro - 2; s.bound1 < s.bound2; s.bound1++, s.bound2--){
+        s.board[0] = bit = 1ULL << s.bound1;
+
+        uint64_t diag1 = bit << 1, linhas = bit, diag2 = bit >> 1;
+        uint64_t livres = mascaraTabuleiro & ~(diag1 | linhas | diag2);
+        if(1 < s.bound1){
+            livres &= ~s.sidemask;
+        }
+
+        while(livres){
+            uint64_t b = livres & -livres;
+            livres ^= b;
+            s.board[1] = b;
+
+            #pragma omp atomic
+            nTarefas++;
+            INSTR_TAREFA_CRIADA();
+
+            #pragma omp task firstprivate(s, b, diag1, linhas, diag2)
+            {
+                INSTR_INICIO_TAREFA();
+                backtrackBorda(&s, 2, (diag1 | b) << 1, linhas | b, (diag2 | b) >> 1);
+                contabilizarSimetria(&s);
+                INSTR_FIM_TAREFA();
+            }
+        }
+        s.lastmask |= s.lastmask >> 1 | s.lastmask << 1;
+        s.endbit >>= 1;
+    }
+}
+
+// Conta os prefixos válidos com as primeiras colunas preenchidas
+long long contarPrefixos(uint64_t linhas, uint64_t diag1, uint64_t diag2, int restantes){
+    if(restantes == 0){
+        return 1;
+    }
+
+    long long total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        total += contarPrefixos(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, restantes - 1);
+    }
+    return total;
+}
+
+// Estima o número de nós da árvore completa do motor de bits pelo método de Knuth
+// Cada sonda desce por um caminho aleatório e soma os produtos dos fatores de ramificação;
+// a média das sondas é uma estimativa sem viés (semente fixa: a decisão é reproduzível)
+double estimarArvore(){
+    uint64_t semente = 0x9E3779B97F4A7C15ULL;
+    double soma = 0.0;
+
+    for(int sonda = 0; sonda < SONDAS_ESTIMATIVA; sonda++){
+        uint64_t linhas = 0, diag1 = 0, diag2 = 0;
+        double peso = 1.0, nos = 1.0;
+
+        for(;;){
+            uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+            int ramos = __builtin_popcountll(livres);
+            if(ramos == 0){
+                break;
+            }
+            peso *= ramos;
+            nos += peso;
+
+            // Sorteia um dos ramos (xorshift) e desce por ele
+            semente ^= semente << 13;
+            semente ^= semente >> 7;
+            semente ^= semente << 17;
+            for(int r = semente % ramos; r > 0; r--){
+                livres &= livres - 1;
+            }
+            uint64_t bit = livres & -livres;
+            linhas |= bit;
+            diag1 = (diag1 | bit) << 1;
+            diag2 = (diag2 | bit) >> 1;
+        }
+        soma += nos;
+    }
+    return soma / SONDAS_ESTIMATIVA;
+}
+
+// Escolhe quantas threads a busca principal usa a partir da árvore estimada
+// Árvores pequenas não pagam a criação da equipe e das tarefas
+int escolherEquipe(double estimativa){
+    double equipe = estimativa / NOS_POR_THREAD;
+
+    if(equipe < 1.0){
+        return 1;
+    }
+    return (equipe < nThreads) ? (int)equipe : nThreads;
+}
+
+// Escolhe a menor profundidade de corte que gera prefixos suficientes para as threads
+// Tarefas mais rasas deixam threads ociosas; mais profundas pagam overhead de criação
+int ajustarCorte(){
+    int prof;
+
+    for(prof = 1; prof < TamTabuleiro - 1; prof++){
+        if(contarPrefixos(0, 0, 0, prof) >= PREFIXOS_POR_THREAD * nEquipe){
+            break;
+        }
+    }
+    return prof;
+}
+
+// Enumera os prefixos válidos das primeiras k colunas em ordem determinística
+// Com vetor nulo apenas conta; no modo espelho aplica os mesmos limites da busca
+long long gerarPrefixos(Prefixo *vetor, long long n, uint64_t linhas, uint64_t diag1, uint64_t diag2, int col, int k){
+    int meio = TamTabuleiro / 2;
+
+    if(col == k){
+        if(vetor != NULL){
+            vetor[n].linhas = linhas;
+            vetor[n].diag1 = diag1;
+            vetor[n].diag2 = diag2;
+        }
+        return n + 1;
+    }
+
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    if(simetria == SIMETRIA_ESPELHO){
+        // Metade superior da primeira coluna (incluindo a linha central)
+        if(col == 0){
+            livres &= (1ULL << ((TamTabuleiro + 1) / 2)) - 1;
+        }
+        // Dama na linha central: a segunda coluna é que é dividida ao meio
+        else if(col == 1 && TamTabuleiro % 2 == 1 && linhas == (1ULL << meio)){
+            livres &= (1ULL << meio) - 1;
+        }
+    }
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        n = gerarPrefixos(vetor, n, linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, col + 1, k);
+    }
+    return n;
+}
+
+// Lê o checkpoint existente marcando as unidades concluídas
+// Retorna o tamanho em bytes da parte íntegra do arquivo (registros completos)
+long lerCheckpoint(const char *arquivo, CabecalhoCheckpoint *esperado, char *concluida){
+    CabecalhoCheckpoint cab;
+    RegistroCheckpoint reg;
+    FILE *fp = fopen(arquivo, "rb");
+    long integro;
+
+    if(fp == NULL){
+        return 0;
+    }
+
+    // Arquivo vazio ou cortado antes do fim do cabeçalho: recomeça do zero
+    if(fread(&cab, sizeof(cab), 1, fp) != 1){
+        fclose(fp);
+        return 0;
+    }
+    if(memcmp(cab.magica, esperado->magica, 4) != 0 || cab.tamanho != esperado->tamanho ||
+       cab.prefixo != esperado->prefixo || cab.simetria != esperado->simetria ||
+       cab.unidades != esperado->unidades){
+        fprintf(stdout, "Checkpoint %s pertence a outra execução (N=%u, k=%u)\n", arquivo, cab.tamanho, cab.prefixo);
+        exit(-1);
+    }
+
+    integro = sizeof(cab);
+    while(fread(&reg, sizeof(reg), 1, fp) == 1){
+        if(reg.indice < nUnidades && !concluida[reg.indice]){
+            concluida[reg.indice] = 1;
+            contagemRetomada += reg.contagem;
+            nRetomadas++;
+        }
+        integro += sizeof(reg);
+    }
+    fclose(fp);
+    return integro;
+}
+
+// Lê o prefixo gravado no cabeçalho de um checkpoint existente (0 se não houver)
+int prefixoCheckpoint(const char *arquivo){
+    CabecalhoCheckpoint cab;
+    FILE *fp = fopen(arquivo, "rb");
+    int k = 0;
+
+    if(fp != NULL){
+        if(fread(&cab, sizeof(cab), 1, fp) == 1 && memcmp(cab.magica, "NDCK", 4) == 0){
+            k = cab.prefixo;
+        }
+        fclose(fp);
+    }
+    return k;
+}
+
+// Enumera as unidades de trabalho de k colunas (modos checkpoint e coordenador)
+// Com arquivo de checkpoint, retoma as unidades concluídas e abre o arquivo para anexar
+void prepararUnidades(const char *arquivo, int k){
+    CabecalhoCheckpoint cab;
+    long integro;
+
+    // Enumera as unidades (primeira passada conta, segunda preenche)
+    nUnidades = gerarPrefixos(NULL, 0, 0, 0, 0, 0, k);
+    prefixos = (Prefixo *)alocar((nUnidades + 1) * sizeof(Prefixo));
+    concluida = (char *)alocar(nUnidades + 1);
+    memset(concluida, 0, nUnidades + 1);
+    gerarPrefixos(prefixos, 0, 0, 0, 0, 0, k);
+
+    if(arquivo == NULL){
+        return;
+    }
+
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, "NDCK", 4);
+    cab.tamanho = TamTabuleiro;
+    cab.prefixo = k;
+    cab.simetria = simetria;
+    cab.unidades = nUnidades;
+
+    // Retoma as unidades concluídas e descarta um registro incompleto no final
+    integro = lerCheckpoint(arquivo, &cab, concluida);
+    if(integro > 0){
+        if(truncate(arquivo, integro) != 0){
+            perror("Erro ao truncar o checkpoint");
+            exit(-1);
+        }
+        fpCheckpoint = fopen(arquivo, "ab");
+    }
+    else{
+        fpCheckpoint = fopen(arquivo, "wb");
+        if(fpCheckpoint != NULL){
+            fwrite(&cab, sizeof(cab), 1, fpCheckpoint);
+            fflush(fpCheckpoint);
+        }
+    }
+    if(fpCheckpoint == NULL){
+        perror("Erro ao abrir o checkpoint");
+        exit(-1);
+    }
+}
+
+// Grava uma unidade concluída no checkpoint de forma durável (se houver checkpoint)
+void registrarUnidade(long long u, contagem_t parcial){
+    RegistroCheckpoint reg;
+
+    if(fpCheckpoint == NULL){
+        return;
+    }
+    reg.indice = (uint32_t)u;
+    reg.contagem = (uint64_t)parcial;
+
+    #pragma omp critical(checkpoint)
+    {
+        fwrite(&reg, sizeof(reg), 1, fpCheckpoint);
+        fflush(fpCheckpoint);
+        fsync(fileno(fpCheckpoint));
+    }
+}
+
+// Fecha o checkpoint e libera as unidades de trabalho
+void encerrarUnidades(){
+    if(fpCheckpoint != NULL){
+        fclose(fpCheckpoint);
+        fpCheckpoint = NULL;
+    }
+    free(prefixos);
+    free(concluida);
+}
+
+// Conta as soluções dividindo a árvore em unidades independentes (prefixos de k colunas)
+// Cada unidade concluída é anexada ao checkpoint; unidades já registradas são puladas
+// Chamada dentro da região paralela (single), distribuindo as unidades em tarefas
+void solveNQCheckpoint(const char *arquivo, int k){
+    prepararUnidades(arquivo, k);
+
+    // Uma tarefa por unidade pendente, executadas conforme as threads ficam livres
+    for(long long u = 0; u < nUnidades; u++){
+        if(concluida[u]){
+            continue;
+        }
+
+        #pragma omp atomic
+        nTarefas++;
+        INSTR_TAREFA_CRIADA();
+
+        #pragma omp task firstprivate(u, k)
+        {
+            INSTR_INICIO_TAREFA();
+            // Sem saída de soluções o tabuleiro não é lido
+            contagem_t parcial = contarSubarvore(prefixos[u].linhas, prefixos[u].diag1, prefixos[u].diag2, k, NULL);
+            contadores[omp_get_thread_num()].solucoes += parcial;
+            registrarUnidade(u, parcial);
+            INSTR_FIM_TAREFA();
+        }
+    }
+
+    // Aguarda todas as unidades antes de fechar o checkpoint
+    #pragma omp taskwait
+
+    encerrarUnidades();
+}
+
+// Interpreta uma configuração inicial: linha da dama em cada coluna, '.' ou '-' para livre
+// Exemplo para N = 6: "1,.,.,.,.,4". Também calcula as linhas atacadas pelas damas fixas
+void lerConfiguracao(const char *texto, Configuracao *c){
+    const char *p = texto;
+    int col = 0;
+
+    c->valida = 0;
+    while(*p != '\0'){
+        char *fim;
+        long linha;
+
+        // Separadores entre as colunas
+        if(*p == ',' || *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'){
+            p++;
+            continue;
+        }
+        if(col >= TamTabuleiro){
+            return;
+        }
+        if(*p == '.' || *p == '-'){
+            c->fixa[col++] = -1;
+            p++;
+            continue;
+        }
+        linha = strtol(p, &fim, 10);
+        if(fim == p || linha < 0 || linha >= TamTabuleiro){
+            return;
+        }
+        c->fixa[col++] = linha;
+        p = fim;
+    }
+    if(col != TamTabuleiro){
+        return;
+    }
+
+    // Linhas e diagonais atacadas por cada dama fixa, projetadas em todas as colunas
+    memset(c->proibidas, 0, sizeof(c->proibidas));
+    for(int f = 0; f < TamTabuleiro; f++){
+        int r = c->fixa[f];
+
+        if(r < 0){
+            continue;
+        }
+        for(int j = 0; j < TamTabuleiro; j++){
+            int d = (j > f) ? j - f : f - j;
+
+            // Outra dama fixa atacada por esta: configuração sem completamento válido
+            if(j != f && c->fixa[j] >= 0 && (c->fixa[j] == r || c->fixa[j] == r + d || c->fixa[j] == r - d)){
+                return;
+            }
+            c->proibidas[j] |= 1ULL << r;
+            if(r + d < TamTabuleiro){
+                c->proibidas[j] |= 1ULL << (r + d);
+            }
+            if(r - d >= 0){
+                c->proibidas[j] |= 1ULL << (r - d);
+            }
+        }
+    }
+    c->valida = 1;
+}
+
+// Lê as configurações de um arquivo (uma por linha, '-' para a entrada padrão)
+// Linhas vazias ou iniciadas por '#' são ignoradas
+Configuracao *lerConfiguracoes(const char *arquivo, int *quantas){
+    Configuracao *v = NULL;
+    int capacidade = 0;
+    char linha[1024];
+    FILE *fp = (strcmp(arquivo, "-") == 0) ? stdin : fopen(arquivo, "r");
+
+    if(fp == NULL){
+        perror("Erro ao abrir o arquivo de configurações");
+        exit(-1);
+    }
+
+    *quantas = 0;
+    while(fgets(linha, sizeof(linha), fp) != NULL){
+        if(linha[0] == '#' || linha[strspn(linha, " \t\r\n")] == '\0'){
+            continue;
+        }
+        if(*quantas == capacidade){
+            v = (Configuracao *)realocar(v, capacidade * sizeof(Configuracao),
+                                         (capacidade ? 2 * capacidade : 64) * sizeof(Configuracao));
+            capacidade = capacidade ? 2 * capacidade : 64;
+        }
+        lerConfiguracao(linha, &v[(*quantas)++]);
+    }
+    if(fp != stdin){
+        fclose(fp);
+    }
+    return v;
+}
+
+// Conta os completamentos de uma configuração com as máscaras do motor de bits
+// As máscaras dinâmicas guardam apenas as damas das colunas livres: as fixas já
+// entram pelas linhas proibidas, então suas colunas são puladas sem nova busca
+// No modo encontrar a busca para no primeiro completamento, deixado em board
+contagem_t completarConfiguracao(const Configuracao *c, uint64_t linhas, uint64_t diag1, uint64_t diag2,
+                                 int col, int *board, int encontrar){
+    // Pula as colunas fixas, apenas deslocando as diagonais
+    while(col < TamTabuleiro && c->fixa[col] >= 0){
+        board[col] = c->fixa[col];
+        diag1 <<= 1;
+        diag2 >>= 1;
+        col++;
+    }
+    if(col == TamTabuleiro){
+        if(fpSaida != NULL){
+            gravarSolucao(board);
+        }
+        return 1;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2 | c->proibidas[col]) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        board[col] = __builtin_ctzll(bit);
+        total += completarConfiguracao(c, linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, col + 1, board, encontrar);
+        if(encontrar && total > 0){
+            break;
+        }
+    }
+    return total;
+}
+
+// Modo de completamento: resolve cada configuração inicial e exibe o resultado de cada uma
+// Cada configuração válida vira uma tarefa; o tempo cobre apenas a busca
+void resolverConfiguracoes(const char *unica, const char *arquivo, int encontrar, FILE *relatorio){
+    Configuracao *v;
+    contagem_t *resultados;
+    int *completos;
+    int quantas, invalidas = 0;
+    char texto[48];
+    struct timeval start, stop;
+
+    if(unica != NULL){
+        v = (Configuracao *)alocar(sizeof(Configuracao));
+        quantas = 1;
+        lerConfiguracao(unica, v);
+    }
+    else{
+        v = lerConfiguracoes(arquivo, &quantas);
+    }
+    resultados = (contagem_t *)alocar((quantas + 1) * sizeof(contagem_t));
+    completos = (int *)alocar((quantas + 1) * TamTabuleiro * sizeof(int));
+    memset(resultados, 0, (quantas + 1) * sizeof(contagem_t));
+
+    // Obtém o tempo inicial
+    gettimeofday(&start, NULL);
+
+    #pragma omp parallel num_threads(nThreads)
+    {
+        #pragma omp single
+        {
+            for(int k = 0; k < quantas; k++){
+                if(!v[k].valida){
+                    continue;
+                }
+
+                #pragma omp atomic
+                nTarefas++;
+                INSTR_TAREFA_CRIADA();
+
+                #pragma omp task firstprivate(k)
+                {
+                    INSTR_INICIO_TAREFA();
+                    resultados[k] = completarConfiguracao(&v[k], 0, 0, 0, 0, &completos[k * TamTabuleiro], encontrar);
+                    INSTR_FIM_TAREFA();
+                }
+            }
+        }
+    }
+
+    // Obtém o tempo final
+    gettimeofday(&stop, NULL);
+    double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
+
+    // Resultado de cada configuração, na ordem de entrada
+    nSolutions = 0;
+    for(int k = 0; k < quantas; k++){
+        nSolutions += resultados[k];
+        if(!v[k].valida){
+            invalidas++;
+            fprintf(relatorio, "Configuração %d: inválida\n", k + 1);
+        }
+        else if(!encontrar){
+            fprintf(relatorio, "Configuração %d: %s completamentos\n", k + 1, formatarContagem(resultados[k], texto));
+        }
+        else if(resultados[k] == 0){
+            fprintf(relatorio, "Configuração %d: sem completamento\n", k + 1);
+        }
+        else{
+            fprintf(relatorio, "Configuração %d: ", k + 1);
+            for(int col = 0; col < TamTabuleiro; col++){
+                fprintf(relatorio, "(%d, %d) ", completos[k * TamTabuleiro + col], col);
+            }
+            fprintf(relatorio, "\n");
+        }
+    }
+
+    fprintf(relatorio, "Número total de soluções: %s\n", formatarContagem(nSolutions, texto));
+    fprintf(relatorio, "Configurações processadas: %d (inválidas: %d)\n", quantas, invalidas);
+    fprintf(relatorio, "Número de tarefas criadas: %lld\n", nTarefas);
+    fprintf(relatorio, "Alocações no heap: %lld\n", nAlocacoes);
+    fprintf(relatorio, "Tempo decorrido = %g ms\n", t);
+
+    free(v);
+    free(resultados);
+    free(completos);
+}
+
+// Envia uma linha completa pelo socket (sem SIGPIPE se o outro lado caiu)
+int enviarLinha(int fd, const char *linha){
+    size_t total = strlen(linha), enviado = 0;
+
+    while(enviado < total){
+        ssize_t n = send(fd, linha + enviado, total - enviado, MSG_NOSIGNAL);
+        if(n <= 0){
+            return -1;
+        }
+        enviado += n;
+    }
+    return 0;
+}
+
+// Fila circular de unidades pendentes do coordenador
+static long long *filaUnidades;
+static long long inicioFila = 0, tamFila = 0;
+
+void enfileirarUnidade(long long u){
+    filaUnidades[(inicioFila + tamFila) % nUnidades] = u;
+    tamFila++;
+}
+
+long long desenfileirarUnidade(){
+    long long u = filaUnidades[inicioFila];
+    inicioFila = (inicioFila + 1) % nUnidades;
+    tamFila--;
+    return u;
+}
+
+// Entrega a próxima unidade pendente a um trabalhador ocioso
+void entregarUnidade(Trabalhador *t){
+    char linha[128];
+    long long u;
+
+    if(t->fd < 0 || !t->identificado || t->unidade >= 0 || tamFila == 0){
+        return;
+    }
+    u = desenfileirarUnidade();
+    snprintf(linha, sizeof(linha), "UNIDADE %lld %llx %llx %llx\n", u,
+             (unsigned long long)prefixos[u].linhas, (unsigned long long)prefixos[u].diag1,
+             (unsigned long long)prefixos[u].diag2);
+    t->unidade = u;
+
+    // Falha no envio: a unidade volta para a fila e a conexão é descartada
+    if(enviarLinha(t->fd, linha) != 0){
+        close(t->fd);
+        t->fd = -1;
+        t->unidade = -1;
+        enfileirarUnidade(u);
+        nReenvios++;
+    }
+}
+
+// Encerra a conexão de um trabalhador, devolvendo sua unidade à fila
+void desconectarTrabalhador(Trabalhador *t){
+    close(t->fd);
+    t->fd = -1;
+    if(t->unidade >= 0){
+        fprintf(stderr, "Trabalhador caiu; unidade %lld reenviada\n", t->unidade);
+        enfileirarUnidade(t->unidade);
+        t->unidade = -1;
+        nReenvios++;
+    }
+}
+
+// Trata uma linha recebida de um trabalhador
+// Retorna 1 se uma unidade foi concluída
+int tratarMensagem(Trabalhador *t, char *linha){
+    long long u;
+    unsigned long long valor;
+    int n;
+
+    if(sscanf(linha, "OLA %d", &n) == 1){
+        if(n != TamTabuleiro){
+            desconectarTrabalhador(t);
+            return 0;
+        }
+        t->identificado = 1;
+        return 0;
+    }
+    if(sscanf(linha, "CONTAGEM %lld %llu", &u, &valor) == 2 && u == t->unidade){
+        t->unidade = -1;
+        if(!concluida[u]){
+            concluida[u] = 1;
+            contadores[0].solucoes += valor;
+            registrarUnidade(u, valor);
+            return 1;
+        }
+        return 0;
+    }
+    desconectarTrabalhador(t);
+    return 0;
+}
+
+// Inicia um trabalhador local executando o próprio binário e devolve seu processo
+pid_t iniciarTrabalhadorLocal(const char *programa, int porta){
+    char tam[16], alvo[32];
+    pid_t pid;
+
+    snprintf(tam, sizeof(tam), "%d", TamTabuleiro);
+    snprintf(alvo, sizeof(alvo), "127.0.0.1:%d", porta);
+    pid = fork();
+    if(pid == 0){
+        // Os trabalhadores locais herdam a memoização do coordenador
+        if(memoMax > 0){
+            char janela[32], megabytes[32];
+            snprintf(janela, sizeof(janela), "%d:%d", memoMax, memoMin);
+            snprintf(megabytes, sizeof(megabytes), "%ld", memoMB);
+            execl("/proc/self/exe", programa, tam, "-W", alvo, "-M", janela, "-H", megabytes, (char *)NULL);
+        }
+        else{
+            execl("/proc/self/exe", programa, tam, "-W", alvo, (char *)NULL);
+        }
+        perror("Erro ao iniciar trabalhador");
+        _exit(-1);
+    }
+    return pid;
+}
+
+// Modo coordenador: distribui as unidades de k colunas para processos trabalhadores
+// Os trabalhadores conectam por TCP (locais ou em outras máquinas com o mesmo binário)
+// A queda de um trabalhador devolve sua unidade para a fila; trabalhadores locais encerrados são reiniciados
+// Sem trabalhadores conectados nem locais ativos a contagem não avançaria: o coordenador encerra com erro
+void coordenarTrabalhadores(const char *programa, const char *arquivo, int k, int porta, int locais){
+    static Trabalhador trab[MAX_TRABALHADORES];
+    struct pollfd fds[MAX_TRABALHADORES + 1];
+    struct sockaddr_in endereco;
+    socklen_t tamEndereco = sizeof(endereco);
+    long long restantes;
+    pid_t filhos[MAX_TRABALHADORES];
+    int reinicios[MAX_TRABALHADORES];
+    int servidor, opcao = 1;
+
+    prepararUnidades(arquivo, k);
+    filaUnidades = (long long *)alocar((nUnidades + 1) * sizeof(long long));
+    for(long long u = 0; u < nUnidades; u++){
+        if(!concluida[u]){
+            enfileirarUnidade(u);
+        }
+    }
+    restantes = tamFila;
+    for(int t = 0; t < MAX_TRABALHADORES; t++){
+        trab[t].fd = -1;
+    }
+
+    // Socket de escuta (porta 0 escolhe uma porta livre)
+    servidor = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    setsockopt(servidor, SOL_SOCKET, SO_REUSEADDR, &opcao, sizeof(opcao));
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sin_family = AF_INET;
+    endereco.sin_addr.s_addr = htonl(INADDR_ANY);
+    endereco.sin_port = htons(porta);
+    if(servidor < 0 || bind(servidor, (struct sockaddr *)&endereco, sizeof(endereco)) != 0 ||
+       listen(servidor, MAX_TRABALHADORES) != 0){
+        perror("Erro ao abrir a porta do coordenador");
+        exit(-1);
+    }
+    getsockname(servidor, (struct sockaddr *)&endereco, &tamEndereco);
+    porta = ntohs(endereco.sin_port);
+    fprintf(stderr, "Coordenador aguardando trabalhadores na porta %d\n", porta);
+
+    // Inicia os trabalhadores locais executando o próprio binário
+    for(int w = 0; w < locais && w < MAX_TRABALHADORES; w++){
+        filhos[w] = iniciarTrabalhadorLocal(programa, porta);
+        reinicios[w] = 0;
+    }
+
+    while(restantes > 0){
+        int nfds = 1, conectados = 0, ativos = 0;
+
+        fds[0].fd = servidor;
+        fds[0].events = POLLIN;
+        for(int t = 0; t < MAX_TRABALHADORES; t++){
+            fds[t + 1].fd = trab[t].fd;
+            fds[t + 1].events = POLLIN;
+            fds[t + 1].revents = 0;
+            if(trab[t].fd >= 0){
+                nfds = t + 2;
+            }
+        }
+        // Com trabalhadores locais a espera é limitada para conferir seus processos
+        if(poll(fds, nfds, locais > 0 ? INTERVALO_LOCAIS_MS : -1) < 0){
+            continue;
+        }
+
+        // Nova conexão de trabalhador
+        if(fds[0].revents & POLLIN){
+            int fd = accept(servidor, NULL, NULL);
+            int livre = -1;
+
+            for(int t = 0; t < MAX_TRABALHADORES && livre < 0; t++){
+                if(trab[t].fd < 0){
+                    livre = t;
+                }
+            }
+            if(fd >= 0 && livre >= 0){
+                trab[livre].fd = fd;
+                trab[livre].identificado = 0;
+                trab[livre].unidade = -1;
+                trab[livre].usado = 0;
+                nConexoes++;
+            }
+            else if(fd >= 0){
+                close(fd);
+            }
+        }
+
+        // Mensagens dos trabalhadores conectados
+        for(int t = 0; t < nfds - 1; t++){
+            Trabalhador *tr = &trab[t];
+            ssize_t n;
+            char *fim;
+
+            if(tr->fd < 0 || !(fds[t + 1].revents & (POLLIN | POLLHUP | POLLERR))){
+                continue;
+            }
+            n = recv(tr->fd, tr->buffer + tr->usado, sizeof(tr->buffer) - 1 - tr->usado, 0);
+            if(n <= 0){
+                desconectarTrabalhador(tr);
+                continue;
+            }
+            tr->usado += n;
+            tr->buffer[tr->usado] = '\0';
+
+            // Processa cada linha completa recebida
+            while(tr->fd >= 0 && (fim = strchr(tr->buffer, '\n')) != NULL){
+                *fim = '\0';
+                restantes -= tratarMensagem(tr, tr->buffer);
+                tr->usado -= (fim + 1 - tr->buffer);
+                memmove(tr->buffer, fim + 1, tr->usado + 1);
+            }
+            if(tr->usado >= (int)sizeof(tr->buffer) - 1){
+                desconectarTrabalhador(tr);
+            }
+        }
+
+        // Entrega unidades pendentes (inclusive as reenviadas) aos ociosos
+        for(int t = 0; t < MAX_TRABALHADORES; t++){
+            entregarUnidade(&trab[t]);
+            conectados += (trab[t].fd >= 0);
+        }
+        if(restantes == 0){
+            break;
+        }
+
+        // Trabalhadores locais encerrados antes do fim são reiniciados até REINICIOS_LOCAIS vezes
+        for(int w = 0; w < locais && w < MAX_TRABALHADORES; w++){
+            if(filhos[w] > 0 && waitpid(filhos[w], NULL, WNOHANG) == filhos[w]){
+                filhos[w] = -1;
+                if(reinicios[w] < REINICIOS_LOCAIS){
+                    fprintf(stderr, "Trabalhador local %d encerrado; reiniciando\n", w);
+                    filhos[w] = iniciarTrabalhadorLocal(programa, porta);
+                    reinicios[w]++;
+                }
+            }
+            ativos += (filhos[w] > 0);
+        }
+
+        // Nenhum trabalhador restante: sem locais ativos, só encerra depois que algum já conectou
+        if(conectados == 0 && ativos == 0 && (locais > 0 || nConexoes > 0)){
+            fprintf(stdout, "Todos os trabalhadores caíram com %lld unidades pendentes%s\n", restantes,
+                    arquivo != NULL ? " (as unidades concluídas estão no checkpoint)" : "");
+            exit(-1);
+        }
+    }
+
+    // Dispensa os trabalhadores e aguarda os processos locais
+    for(int t = 0; t < MAX_TRABALHADORES; t++){
+        if(trab[t].fd >= 0){
+            enviarLinha(trab[t].fd, "FIM\n");
+            close(trab[t].fd);
+        }
+    }
+    close(servidor);
+    for(int w = 0; w < locais && w < MAX_TRABALHADORES; w++){
+        if(filhos[w] > 0){
+            waitpid(filhos[w], NULL, 0);
+        }
+    }
+
+    free(filaUnidades);
+    encerrarUnidades();
+}
+
+// Modo trabalhador: recebe unidades do coordenador e devolve suas contagens
+// Cada unidade é contada com as tarefas do motor de bits a partir do prefixo recebido
+void executarTrabalhador(const char *destino){
+    struct addrinfo dicas, *res = NULL;
+    char host[256], linha[256], texto[48];
+    char *separador;
+    Tabuleiro raiz;
+    FILE *entrada;
+    int fd = -1;
+
+    // Separa host e porta ("host:porta")
+    snprintf(host, sizeof(host), "%s", destino);
+    separador = strrchr(host, ':');
+    if(separador == NULL){
+        fprintf(stdout, "Endereço do coordenador inválido: %s\n", destino);
+        exit(-1);
+    }
+    *separador = '\0';
+
+    memset(&dicas, 0, sizeof(dicas));
+    dicas.ai_family = AF_UNSPEC;
+    dicas.ai_socktype = SOCK_STREAM;
+
+    // O coordenador pode ainda não estar ouvindo: tenta novamente
+    for(int tentativa = 0; tentativa < TENTATIVAS_CONEXAO && fd < 0; tentativa++){
+        if(getaddrinfo(host, separador + 1, &dicas, &res) == 0){
+            fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+            if(fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0){
+                close(fd);
+                fd = -1;
+            }
+            freeaddrinfo(res);
+        }
+        if(fd < 0){
+            sleep(1);
+        }
+    }
+    if(fd < 0){
+        fprintf(stdout, "Não foi possível conectar ao coordenador %s\n", destino);
+        exit(-1);
+    }
+
+    snprintf(linha, sizeof(linha), "OLA %d\n", TamTabuleiro);
+    enviarLinha(fd, linha);
+
+    entrada = fdopen(fd, "r");
+    while(fgets(linha, sizeof(linha), entrada) != NULL){
+        long long u;
+        unsigned long long linhas, diag1, diag2;
+
+        if(sscanf(linha, "UNIDADE %lld %llx %llx %llx", &u, &linhas, &diag1, &diag2) != 4){
+            break;
+        }
+
+        // Tarefas a partir da coluna do prefixo, sequenciais abaixo do corte
+        int col = __builtin_popcountll(linhas);
+        profCorte = col + PROF_TAREFAS;
+        memset(contadores, 0, nThreads*sizeof(ContadorThread));
+
+        // O trabalhador não grava soluções: o tabuleiro apenas acompanha as tarefas
+        memset(&raiz, 0, sizeof(raiz));
+
+        #pragma omp parallel num_threads(nThreads)
+        {
+            #pragma omp single
+            solveNQBitsParalelo(linhas, diag1, diag2, col, raiz.pos);
+        }
+        reduzirContadores();
+
+        snprintf(linha, sizeof(linha), "CONTAGEM %lld %s\n", u, formatarContagem(nSolutions, texto));
+        if(enviarLinha(fd, linha) != 0){
+            break;
+        }
+    }
+    fclose(entrada);
+}
+
+#ifdef INSTRUMENTACAO
+// Exibe os nós avaliados e as podas por profundidade, a vazão da busca
+// e a distribuição das tarefas e do tempo ocupado entre as threads
+void relatarInstrumentacao(FILE *relatorio, double ms){
+    long long nos = 0, podas = 0;
+
+    fprintf(relatorio, "Instrumentação da busca (profundidade = damas colocadas):\n");
+    fprintf(relatorio, "  %5s %18s %18s\n", "prof", "nos", "podas");
+    for(int p = 0; p <= TamTabuleiro; p++){
+        long long nosProf = 0, podasProf = 0;
+        for(int t = 0; t < nThreads; t++){
+            nosProf += estatisticas[t].nos[p];
+            podasProf += estatisticas[t].podas[p];
+        }
+        if(nosProf == 0 && podasProf == 0){
+            continue;
+        }
+        fprintf(relatorio, "  %5d %18lld %18lld\n", p, nosProf, podasProf);
+        nos += nosProf;
+        podas += podasProf;
+    }
+    fprintf(relatorio, "Nós avaliados: %lld, podas: %lld (%.4g nós/s)\n", nos, podas, ms > 0 ? nos / (ms / 1000.0) : 0.0);
+
+    // Ociosidade: fração do tempo da região paralela em que a thread não executava tarefas
+    fprintf(relatorio, "Distribuição entre as threads:\n");
+    fprintf(relatorio, "  %6s %12s %12s %14s %10s %16s\n", "thread", "criadas", "executadas", "ocupado (ms)", "ociosa", "nos");
+    for(int t = 0; t < nThreads; t++){
+        long long nosThread = 0;
+        for(int p = 0; p <= TamTabuleiro; p++){
+            nosThread += estatisticas[t].nos[p];
+        }
+        double ocupado = estatisticas[t].ocupado * 1000.0;
+        fprintf(relatorio, "  %6d %12lld %12lld %14.3f %9.1f%% %16lld\n", t, estatisticas[t].tarefasCriadas,
+                estatisticas[t].tarefasExecutadas, ocupado, ms > 0 ? 100.0 * (1.0 - ocupado / ms) : 0.0, nosThread);
+    }
+}
+#endif
+
+// Define o tamanho do tabuleiro, a máscara das linhas e o motor especializado para N
+void configurarTabuleiro(int n, int kernelGenerico){
+    TamTabuleiro = n;
+    mascaraTabuleiro = (n == 64) ? ~0ULL : (1ULL << n) - 1;
+
+    // Motor de bits especializado para o N pedido (-G força o motor genérico)
+    kernelContagem = solveNQBits;
+    if(!kernelGenerico && n >= MIN_TAM_ESPECIALIZADO && n <= MAX_TAM_ESPECIALIZADO){
+        kernelContagem = kernelsEspecializados[n];
+    }
+}
+
+// Distribui a busca do motor e do modo de simetria escolhidos (chamada dentro de um single)
+void despacharBusca(int motor, int *board){
+    if(simetria == SIMETRIA_CLASSES){
+        solveNQClassesParalelo();
+    }
+    else if(motor == MOTOR_BITS && simetria == SIMETRIA_ESPELHO && TamTabuleiro > 1){
+        solveNQBitsEspelhoParalelo();
+    }
+    else if(motor == MOTOR_BITS){
+        solveNQBitsParalelo(0, 0, 0, 0, board);
+    }
+    else{
+        solveNQ(board,0);
+    }
+}
+
+// Interpreta a lista de tamanhos do modo lote: valores e intervalos separados por vírgula
+// Exemplo: "8-15" ou "8,10,12-14". Devolve a quantidade de tamanhos (0 se inválida)
+int lerLote(const char *texto, int *tamanhos){
+    int quantos = 0;
+    const char *p = texto;
+
+    while(*p != '\0'){
+        char *fim;
+        long inicio = strtol(p, &fim, 10), final;
+
+        if(fim == p){
+            return 0;
+        }
+        final = inicio;
+        p = fim;
+        if(*p == '-'){
+            final = strtol(p + 1, &fim, 10);
+            if(fim == p + 1 || final < inicio){
+                return 0;
+            }
+            p = fim;
+        }
+        for(long n = inicio; n <= final; n++){
+            if(quantos == MAX_LOTE){
+                return 0;
+            }
+            tamanhos[quantos++] = n;
+        }
+        if(*p == ','){
+            p++;
+        }
+        else if(*p != '\0'){
+            return 0;
+        }
+    }
+    return quantos;
+}
+
+// Executa as contagens do lote com uma equipe de threads por tamanho, mantida entre as repetições
+// Cada repetição imprime uma linha CSV; o tempo cobre apenas a busca, como no modo normal
+// Equipe e corte são escolhidos para cada tamanho como na contagem avulsa; árvores pequenas
+// demais para a equipe são contadas por uma só thread, sem tarefas
+// (o modo classes cria sempre as tarefas das duas primeiras colunas)
+void executarLote(int *tamanhos, int quantos, int repeticoes, int motor, int kernelGenerico,
+                  int corteFixo, int corteAuto, int equipeFixa, int *board, FILE *relatorio){
+    // Compartilhado: o single que registra a repetição pode caber a outra thread
+    double inicio = 0.0;
+
+    fprintf(relatorio, "n,repeticao,solucoes,fundamentais,threads,profundidade,tarefas,tempo_ms\n");
+
+    for(int k = 0; k < quantos; k++){
+        configurarTabuleiro(tamanhos[k], kernelGenerico);
+
+        // Equipe e corte de cada tamanho, como na contagem avulsa
+        int adaptativa = !equipeFixa && simetria != SIMETRIA_CLASSES && TamTabuleiro <= MAX_TAM_BITS;
+        nEquipe = adaptativa ? escolherEquipe(estimarArvore()) : nThreads;
+        if(corteFixo >= 0){
+            profCorte = corteFixo;
+        }
+        else if(nEquipe == 1 && !corteAuto){
+            profCorte = 0;
+        }
+        else if((corteAuto || adaptativa) && TamTabuleiro <= MAX_TAM_BITS){
+            profCorte = ajustarCorte();
+        }
+        else{
+            profCorte = PROF_TAREFAS;
+        }
+
+        // A mesma equipe atende todas as repetições do tamanho
+        #pragma omp parallel num_threads(nEquipe)
+        {
+            for(int r = 1; r <= repeticoes; r++){
+                // Preparação da contagem; as tarefas criadas terminam na barreira do single
+                #pragma omp single
+                {
+                    memset(contadores, 0, nThreads*sizeof(ContadorThread));
+                    nTarefas = 0;
+                    inicio = omp_get_wtime();
+                    despacharBusca(motor, board);
+                }
+
+                // Soma dos contadores e registro da repetição
+                #pragma omp single
+                {
+                    char texto[48], textoFund[48];
+                    double t = (omp_get_wtime() - inicio) * 1000.0;
+
+                    reduzirContadores();
+                    if(simetria == SIMETRIA_ESPELHO && TamTabuleiro > 1){
+                        nSolutions *= 2;
+                    }
+                    fprintf(relatorio, "%d,%d,%s,%s,%d,%d,%lld,%.6f\n", TamTabuleiro, r, formatarContagem(nSolutions, texto),
+                            formatarContagem(nFundamentais, textoFund), nEquipe,
+                            (simetria == SIMETRIA_CLASSES) ? 2 : profCorte, nTarefas, t);
+                }
+            }
+        }
+    }
+}
+
+// Função principal que recebe N de entrada e resolve o problema medindo o tempo de cada execução
+int main(int argc, char *argv[]){
+    int i, *board;
+    int motor = MOTOR_ORIGINAL;
+    int corteAuto = 0;
+    int prefixo = 0;
+    int porta = -1, locais = 0;
+    char *arquivoCheckpoint = NULL;
+    char *coordenador = NULL;
+    char *arquivoSaida = NULL;
+    char *configuracao = NULL, *arquivoConfiguracoes = NULL;
+    int encontrar = 0;
+    int kernelGenerico = 0;
+    int equipeFixa = 0;
+    double estimativa = -1.0;
+    int tamanhos[MAX_LOTE], nLote = 0, repeticoes = 1;
+    char texto[48];
+    FILE *relatorio = stdout;
+    struct timeval start, stop;
+
+    // Verifica se o valor de N foi incluído na linha de comando
+    if(argc <=1){
+        fprintf(stdout, "É necessário especificar o tamanho do tabuleiro\n");
+        fprintf(stdout, "Uso: %s N [-m original|bits|iter] [-s espelho|classes] [-c profundidade|auto] [-r checkpoint] [-k colunas] [-o solucoes.bin|-]" USO_MEMO " [-G] [-t threads] [-F]\n", argv[0]);
+        fprintf(stdout, "     %s N -m bits -C porta [-w trabalhadores locais] [-k colunas] [-r checkpoint]\n", argv[0]);
+        fprintf(stdout, "     %s N -W host:porta" USO_MEMO "\n", argv[0]);
+        fprintf(stdout, "     %s N -p configuracao | -P arquivo [-e] [-o solucoes.bin|-]\n", argv[0]);
+        fprintf(stdout, "     %s N1-N2,N3,... [-R repeticoes] [opções de motor, simetria, corte e threads] (lote em CSV)\n", argv[0]);
+        exit(-1);
+    }
+
+    // Recebe o tamnho do tabuleiro com base na entrada (argv[1])
+    TamTabuleiro = strtol(argv[1], NULL, 10);
+
+    // Uma lista ou intervalo de tamanhos ativa o modo lote
+    // Os limites são conferidos com o maior N da lista e o modo classes com o menor
+    if(strpbrk(argv[1], ",-") != NULL){
+        nLote = lerLote(argv[1], tamanhos);
+        if(nLote == 0){
+            fprintf(stdout, "Lista de tamanhos inválida: %s\n", argv[1]);
+            exit(-1);
+        }
+        TamTabuleiro = tamanhos[0];
+        for(i = 1; i < nLote; i++){
+            if(tamanhos[i] > TamTabuleiro){
+                TamTabuleiro = tamanhos[i];
+            }
+        }
+    }
+
+    // Sem -t, a variável OMP_NUM_THREADS define as threads disponíveis
+    if(getenv("OMP_NUM_THREADS") != NULL){
+        nThreads = omp_get_max_threads();
+    }
+
+    // Sem corte explícito, todos os motores criam tarefas só nas PROF_TAREFAS primeiras colunas
+    profCorte = -1;
+
+    // Opções adicionais após o tamanho do tabuleiro
+    for(i = 2; i < argc; i++){
+        if(strcmp(argv[i], "-m") == 0 && i + 1 < argc){
+            i++;
+            if(strcmp(argv[i], "original") == 0){
+                motor = MOTOR_ORIGINAL;
+            }
+            else if(strcmp(argv[i], "bits") == 0){
+                motor = MOTOR_BITS;
+            }
+            else if(strcmp(argv[i], "iter") == 0){
+                motor = MOTOR_ITER;
+            }
+            else{
+                fprintf(stdout, "Motor desconhecido: %s\n", argv[i]);
+                exit(-1);
+            }
+        }
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc){
+            i++;
+            if(strcmp(argv[i], "espelho") == 0){
+                simetria = SIMETRIA_ESPELHO;
+            }
+            else if(strcmp(argv[i], "classes") == 0){
+                simetria = SIMETRIA_CLASSES;
+            }
+            else{
+                fprintf(stdout, "Modo de simetria desconhecido: %s\n", argv[i]);
+                exit(-1);
+            }
+        }
+        else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc){
+            i++;
+            if(strcmp(argv[i], "auto") == 0){
+                corteAuto = 1;
+            }
+            else{
+                profCorte = strtol(argv[i], NULL, 10);
+                if(profCorte < 0){
+                    fprintf(stdout, "Profundidade de corte inválida: %s\n", argv[i]);
+                    exit(-1);
+                }
+            }
+        }
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc){
+            arquivoCheckpoint = argv[++i];
+        }
+        else if(strcmp(argv[i], "-k") == 0 && i + 1 < argc){
+            prefixo = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-C") == 0 && i + 1 < argc){
+            porta = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-w") == 0 && i + 1 < argc){
+            locais = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-W") == 0 && i + 1 < argc){
+            coordenador = argv[++i];
+        }
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc){
+            arquivoSaida = argv[++i];
+        }
+        else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc){
+            configuracao = argv[++i];
+        }
+        else if(strcmp(argv[i], "-P") == 0 && i + 1 < argc){
+            arquivoConfiguracoes = argv[++i];
+        }
+        else if(strcmp(argv[i], "-e") == 0){
+            encontrar = 1;
+        }
+#ifdef MEMOIZACAO
+        else if(strcmp(argv[i], "-M") == 0 && i + 1 < argc){
+            // Janela de colunas restantes: apenas o limite superior fixa uma única profundidade
+            i++;
+            if(sscanf(argv[i], "%d:%d", &memoMax, &memoMin) < 2){
+                memoMin = memoMax;
+            }
+        }
+        else if(strcmp(argv[i], "-H") == 0 && i + 1 < argc){
+            memoMB = strtol(argv[++i], NULL, 10);
+        }
+#endif
+        else if(strcmp(argv[i], "-G") == 0){
+            kernelGenerico = 1;
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc){
+            nThreads = strtol(argv[++i], NULL, 10);
+            if(nThreads < 1){
+                fprintf(stdout, "Número de threads inválido: %s\n", argv[i]);
+                exit(-1);
+            }
+        }
+        else if(strcmp(argv[i], "-F") == 0){
+            equipeFixa = 1;
+        }
+        else if(strcmp(argv[i], "-R") == 0 && i + 1 < argc){
+            repeticoes = strtol(argv[++i], NULL, 10);
+        }
+        else{
+            fprintf(stdout, "Opção desconhecida: %s\n", argv[i]);
+            exit(-1);
+        }
+    }
+
+    // O motor iterativo substitui apenas a contagem das subárvores do motor de bits
+    if(motor == MOTOR_ITER){
+        folhaIterativa = 1;
+        motor = MOTOR_BITS;
+    }
+
+    // Verifica se o tabuleiro cabe nos limites do motor escolhido
+    if(TamTabuleiro < 1 || TamTabuleiro > MAX_TAM_TABULEIRO || (motor == MOTOR_BITS && TamTabuleiro > MAX_TAM_BITS)){
+        fprintf(stdout, "Tamanho de tabuleiro inválido: %d\n", TamTabuleiro);
+        exit(-1);
+    }
+
+    // O lote conta tabuleiros completos em sequência, sem arquivos ou processos auxiliares
+    if(nLote > 0){
+        for(i = 0; i < nLote; i++){
+            if(tamanhos[i] < 1 || (simetria == SIMETRIA_CLASSES && tamanhos[i] < 4)){
+                fprintf(stdout, "Tamanho de tabuleiro inválido no lote: %d\n", tamanhos[i]);
+                exit(-1);
+            }
+        }
+        if(repeticoes < 1 || arquivoCheckpoint != NULL || porta >= 0 || coordenador != NULL || arquivoSaida != NULL ||
+           configuracao != NULL || arquivoConfiguracoes != NULL || memoMax > 0){
+            fprintf(stdout, "O modo lote exige repetições >= 1 e não usa checkpoint, coordenador, saída, completamento ou memoização\n");
+            exit(-1);
+        }
+    }
+
+    // A classificação por simetrias depende das máscaras do motor de bits
+    if(simetria == SIMETRIA_CLASSES && (motor != MOTOR_BITS || TamTabuleiro < 4)){
+        fprintf(stdout, "O modo classes exige o motor de bits e N >= 4\n");
+        exit(-1);
+    }
+    configurarTabuleiro(TamTabuleiro, kernelGenerico);
+
+    // Os modos checkpoint e coordenador dividem a árvore do motor de bits em prefixos de k colunas
+    // Sem -k, uma execução retomada usa o k gravado no checkpoint
+    if(arquivoCheckpoint != NULL || porta >= 0){
+        if(motor != MOTOR_BITS || simetria == SIMETRIA_CLASSES){
+            fprintf(stdout, "Os modos checkpoint e coordenador exigem o motor de bits (sem o modo classes)\n");
+            exit(-1);
+        }
+        if(prefixo == 0 && arquivoCheckpoint != NULL){
+            prefixo = prefixoCheckpoint(arquivoCheckpoint);
+        }
+        if(prefixo == 0){
+            prefixo = ajustarCorte();
+        }
+        if(prefixo < 1 || prefixo >= TamTabuleiro || (simetria == SIMETRIA_ESPELHO && prefixo < 2)){
+            fprintf(stdout, "Número de colunas do prefixo inválido: %d\n", prefixo);
+            exit(-1);
+        }
+    }
+
+    // O completamento usa as máscaras do motor de bits e percorre a árvore inteira
+    if((configuracao != NULL || arquivoConfiguracoes != NULL) &&
+       (TamTabuleiro > MAX_TAM_BITS || simetria != SIMETRIA_NENHUMA || arquivoCheckpoint != NULL || porta >= 0)){
+        fprintf(stdout, "O modo de completamento exige N <= %d e não usa simetria, checkpoint ou coordenador\n", MAX_TAM_BITS);
+        exit(-1);
+    }
+
+    // A memoização guarda apenas contagens das subárvores do motor de bits (o trabalhador sempre o usa)
+    if(memoMax > 0){
+        if((motor != MOTOR_BITS && coordenador == NULL) || simetria == SIMETRIA_CLASSES || arquivoSaida != NULL ||
+           configuracao != NULL || arquivoConfiguracoes != NULL){
+            fprintf(stdout, "A memoização exige o motor de bits, sem o modo classes, a saída de soluções ou o completamento\n");
+            exit(-1);
+        }
+        if(memoMin < MEMO_RESTANTES_MIN || memoMin > memoMax || memoMax >= TamTabuleiro || memoMB < 1){
+            fprintf(stdout, "Janela de memoização inválida: %d:%d (colunas restantes entre %d e N-1)\n",
+                    memoMax, memoMin, MEMO_RESTANTES_MIN);
+            exit(-1);
+        }
+    }
+
+    // A saída binária enumera todas as soluções dentro deste processo
+    if(arquivoSaida != NULL && (simetria == SIMETRIA_CLASSES || arquivoCheckpoint != NULL || porta >= 0 || coordenador != NULL)){
+        fprintf(stdout, "A saída de soluções não é compatível com os modos classes, checkpoint e coordenador\n");
+        exit(-1);
+    }
+
+    // Corte pedido explicitamente (-c), reaplicado a cada tamanho do lote
+    int profCorteExplicito = profCorte;
+
+    // Equipe adaptativa da busca principal (-F mantém todas as threads)
+    // Os modos checkpoint, coordenador e completamento usam sempre a equipe completa
+    // No modo lote a equipe e o corte são escolhidos para cada tamanho
+    nEquipe = nThreads;
+    if(!equipeFixa && TamTabuleiro <= MAX_TAM_BITS && arquivoCheckpoint == NULL && porta < 0 &&
+       coordenador == NULL && configuracao == NULL && arquivoConfiguracoes == NULL && nLote == 0){
+        estimativa = estimarArvore();
+        nEquipe = escolherEquipe(estimativa);
+
+        // Sem corte explícito o corte acompanha a equipe escolhida: com uma só thread
+        // a árvore é contada sem criar tarefas, senão cada thread recebe PREFIXOS_POR_THREAD prefixos
+        if(profCorte < 0 && !corteAuto){
+            profCorte = (nEquipe == 1) ? 0 : ajustarCorte();
+        }
+    }
+
+    // Define a profundidade de corte das tarefas
+    if(corteAuto && TamTabuleiro <= MAX_TAM_BITS && nLote == 0){
+        profCorte = ajustarCorte();
+    }
+    else if(profCorte < 0){
+        profCorte = PROF_TAREFAS;
+    }
+
+    // Alocação dinâmica do tabuleiro
+    board = (int *)alocar(TamTabuleiro*sizeof(int));
+
+    // Contadores privados das threads, zerados antes da busca
+    contadores = (ContadorThread *)alocar(nThreads*sizeof(ContadorThread));
+    memset(contadores, 0, nThreads*sizeof(ContadorThread));
+
+#ifdef INSTRUMENTACAO
+    // Estatísticas privadas das threads, zeradas antes da busca
+    estatisticas = (EstatisticasThread *)alocar(nThreads*sizeof(EstatisticasThread));
+    memset(estatisticas, 0, nThreads*sizeof(EstatisticasThread));
+#endif
+
+    // Tabelas de memoização das threads (o coordenador apenas repassa a janela aos trabalhadores)
+    if(memoMax > 0 && porta < 0){
+        iniciarMemo();
+    }
+
+    // Com as soluções na saída padrão, o relatório segue pela saída de erro
+    if(arquivoSaida != NULL){
+        abrirSaida(arquivoSaida);
+        if(fpSaida == stdout){
+            relatorio = stderr;
+        }
+    }
+
+    // Modo de completamento a partir de configurações iniciais
+    if(configuracao != NULL || arquivoConfiguracoes != NULL){
+        resolverConfiguracoes(configuracao, arquivoConfiguracoes, encontrar, relatorio);
+        if(fpSaida != NULL){
+            fecharSaida();
+        }
+        free(board);
+        free(contadores);
+        return 0;
+    }
+
+    // Modo lote: uma equipe de threads por tamanho, mantida entre as repetições
+    if(nLote > 0){
+        executarLote(tamanhos, nLote, repeticoes, motor, kernelGenerico, corteAuto ? -1 : profCorteExplicito,
+                     corteAuto, equipeFixa, board, relatorio);
+        free(board);
+        free(contadores);
+#ifdef INSTRUMENTACAO
+        free(estatisticas);
+#endif
+        return 0;
+    }
+
+    // Modo trabalhador: atende o coordenador até receber FIM
+    if(coordenador != NULL){
+        executarTrabalhador(coordenador);
+        if(tabelasMemo != NULL){
+            liberarMemo();
+        }
+        free(board);
+        free(contadores);
+        return 0;
+    }
+
+    // Obtém o tempo inicial
+    gettimeofday(&start, NULL);
+ 
+    if(porta >= 0){
+        // Unidades distribuídas entre processos trabalhadores
+        coordenarTrabalhadores(argv[0], arquivoCheckpoint, prefixo, porta, locais);
+    }
+    else{
+        // Resolve o problema das N-Damas coluna por coluna
+        #pragma omp parallel num_threads(nEquipe)
+        {
+            #pragma omp single
+            {
+                // Resolve o problema das N-Damas percorrendo todas as colunas
+                if(arquivoCheckpoint != NULL){
+                    solveNQCheckpoint(arquivoCheckpoint, prefixo);
+                }
+                else{
+                    despacharBusca(motor, board);
+                }
+            }
+        }
+    }
+
+    // Soma única dos contadores das threads e das unidades retomadas do checkpoint
+    reduzirContadores();
+    nSolutions += contagemRetomada;
+
+    // Cada solução explorada no modo espelho possui uma reflexão fora da metade
+    if(simetria == SIMETRIA_ESPELHO && TamTabuleiro > 1){
+        nSolutions *= 2;
+    }
+
+    // Descarrega as soluções ainda nos buffers antes de medir o tempo
+    if(fpSaida != NULL){
+        fecharSaida();
+    }
+  
+    // Obtém o tempo final
+    gettimeofday(&stop, NULL); 
+
+    // Cálculo do tempo gasto pelo processo
+    double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
+
+    // Exibe o total de soluções e o tempo decorrido
+    fprintf(relatorio, "Número total de soluções: %s\n", formatarContagem(nSolutions, texto)); 
+    if(simetria == SIMETRIA_CLASSES){
+        fprintf(relatorio, "Soluções fundamentais (únicas): %s\n", formatarContagem(nFundamentais, texto));
+    }
+    if(arquivoCheckpoint != NULL || porta >= 0){
+        fprintf(relatorio, "Unidades de trabalho: %lld (prefixos de %d colunas), %lld retomadas do checkpoint\n",
+                nUnidades, prefixo, nRetomadas);
+    }
+    if(porta >= 0){
+        fprintf(relatorio, "Trabalhadores conectados: %lld, unidades reenviadas: %lld\n", nConexoes, nReenvios);
+    }
+    else{
+        if(estimativa >= 0){
+            fprintf(relatorio, "Equipe de threads: %d de %d (%s, árvore estimada em %.3g nós)\n", nEquipe, nThreads,
+                    nEquipe == 1 ? "sequencial" : "adaptativa", estimativa);
+        }
+        else{
+            fprintf(relatorio, "Equipe de threads: %d de %d\n", nEquipe, nThreads);
+        }
+
+        // O modo classes distribui sempre as duas primeiras colunas; o checkpoint, uma tarefa por unidade
+        if(simetria == SIMETRIA_CLASSES){
+            fprintf(relatorio, "Profundidade de corte: 2 (fixa no modo classes)\n");
+        }
+        else if(arquivoCheckpoint == NULL){
+            fprintf(relatorio, "Profundidade de corte: %d%s\n", profCorte, corteAuto ? " (auto)" : "");
+        }
+    }
+    fprintf(relatorio, "Número de tarefas criadas: %lld\n", nTarefas);
+    fprintf(relatorio, "Alocações no heap: %lld\n", nAlocacoes);
+    if(tabelasMemo != NULL){
+        long long acertos = 0, falhas = 0;
+        for(int t = 0; t < nThreads; t++){
+            acertos += tabelasMemo[t].acertos;
+            falhas += tabelasMemo[t].falhas;
+        }
+        fprintf(relatorio, "Memoização: %d a %d colunas restantes, %d tabelas de %llu entradas (%zu MB cada)\n",
+                memoMin, memoMax, nThreads, (unsigned long long)mascaraMemo + 1,
+                ((mascaraMemo + 1) * sizeof(EntradaMemo)) >> 20);
+        fprintf(relatorio, "Memoização: %lld acertos, %lld falhas (taxa de acerto %.2f%%)\n", acertos, falhas,
+                acertos + falhas > 0 ? 100.0 * acertos / (acertos + falhas) : 0.0);
+    }
+#ifdef INSTRUMENTACAO
+    // O coordenador não executa a busca: as estatísticas ficam nos trabalhadores
+    if(porta < 0){
+        relatarInstrumentacao(relatorio, t);
+    }
+    free(estatisticas);
+#endif
+    fprintf(relatorio, "Tempo decorrido = %g ms\n", t);
+
+    // Libera o tabuleiro, os contadores e as tabelas de memoização
+    if(tabelasMemo != NULL){
+        liberarMemo();
+    }
     free(board);
+    free(contadores);
 
     return 0;
 }
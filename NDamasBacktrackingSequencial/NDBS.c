@@ -4,21 +4,241 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <sys/time.h>
 
+// Tipo da contagem de soluções: 64 bits representa N <= 27
+// Compilando com -DCONTAGEM_128 a contagem passa a usar 128 bits
+#ifdef CONTAGEM_128
+typedef unsigned __int128 contagem_t;
+#else
+typedef unsigned long long contagem_t;
+#endif
+
+// Motores de contagem disponíveis
+#define MOTOR_ORIGINAL 0      // Varredura do tabuleiro com isSafe
+#define MOTOR_BITS 1          // Linhas e diagonais ocupadas em máscaras de bits
+#define MOTOR_ITER 2          // Motor de bits com pilha explícita no lugar da recursão
+
+// Modos de redução por simetria
+#define SIMETRIA_NENHUMA 0    // Percorre a árvore inteira
+#define SIMETRIA_ESPELHO 1    // Explora metade da primeira coluna e dobra a contagem
+#define SIMETRIA_CLASSES 2    // Classifica as soluções pelo grupo de rotações e reflexões
+
+// Tamanho máximo do tabuleiro no motor de bits (uma palavra de 64 bits)
+#define MAX_TAM_BITS 64
+
+// Faixa de N com motor de bits especializado em tempo de compilação (máscaras de 32 bits)
+#define MIN_TAM_ESPECIALIZADO 4
+#define MAX_TAM_ESPECIALIZADO 32
+
+// Tamanho do buffer da saída binária de soluções (descarregado em blocos)
+#define TAM_BUFFER_SAIDA (1 << 20)
+
+// Memoização das subárvores finais do motor de bits
+#define MEMO_MB_PADRAO 64     // Memória padrão da tabela em MB
+#define MEMO_RESTANTES_MIN 3  // Com menos colunas restantes recontar é mais barato que consultar
+
+// A memoização é experimental e só existe em builds com -DMEMOIZACAO
+// Medida em N=14 e 15, qualquer janela fica mais lenta que o motor de bits sem tabela:
+// perto das folhas a consulta custa mais que recontar e longe delas os estados quase não se repetem
+#ifdef MEMOIZACAO
+#define USO_MEMO " [-M max[:min] [-H MB]]"
+#else
+#define USO_MEMO ""
+#endif
+
+// Limite de tamanhos de tabuleiro em uma execução em lote
+#define MAX_LOTE 256
+
+// Estado da busca com classificação por simetrias (motor de bits)
+// Cada solução fundamental possui 2, 4 ou 8 variantes distintas no grupo D4
+typedef struct{
+    uint64_t board[MAX_TAM_BITS]; // Bit da linha ocupada em cada coluna
+    uint64_t sidemask;            // Linhas das bordas (primeira e última)
+    uint64_t lastmask;            // Linhas proibidas na última coluna
+    uint64_t topbit;              // Bit da última linha
+    uint64_t endbit;              // Linha exigida na última coluna para simetria de 180 graus
+    int bound1, bound2;           // Coluna da primeira dama e sua espelhada
+    contagem_t count2, count4, count8; // Soluções fundamentais por tamanho de classe
+} BuscaSimetria;
+
+// Estado de uma coluna na pilha explícita do motor iterativo
+typedef struct{
+    uint64_t linhas, diag1, diag2; // Máscaras ocupadas ao chegar na coluna
+    uint64_t livres;              // Linhas candidatas ainda não exploradas na coluna
+} NivelPilha;
+
+// Entrada da tabela de memoização: contagem da subárvore a partir de um estado
+// O número de colunas restantes é implícito nas linhas ocupadas
+typedef struct{
+    uint64_t linhas;              // Linhas ocupadas (0 = entrada vazia)
+    uint64_t diag1, diag2;        // Diagonais que ainda atingem linhas livres
+    contagem_t contagem;          // Soluções da subárvore
+} EntradaMemo;
+
+// Configuração inicial do modo de completamento
+// As damas fixas podem estar em quaisquer colunas, não apenas em um prefixo
+typedef struct{
+    int valida;                       // Formato correto e damas fixas sem ataques entre si
+    int fixa[MAX_TAM_BITS];           // Linha da dama fixada em cada coluna (-1 = coluna livre)
+    uint64_t proibidas[MAX_TAM_BITS]; // Linhas atacadas pelas damas fixas em cada coluna
+} Configuracao;
+
+// Cabeçalho do arquivo binário de soluções
+// Cada solução segue como N índices de linha (coluna 0 primeiro) com bitsPorLinha
+// bits cada, empacotados a partir do bit menos significativo e completados até o byte
+typedef struct{
+    char magica[4];               // "NDSO"
+    uint32_t tamanho;             // N do tabuleiro
+    uint32_t bitsPorLinha;        // Bits usados por índice de linha
+} CabecalhoSolucoes;
+
 // Variáveis globais
-static int nSolutions = 0;    // Contador para o total de soluções
-static int TamTabuleiro;      // Tamanho do tabuleiro
+static contagem_t nSolutions = 0; // Contador para o total de soluções
+static contagem_t nFundamentais = 0; // Contador de soluções fundamentais (únicas)
+static int TamTabuleiro;          // Tamanho do tabuleiro
+static uint64_t mascaraTabuleiro; // Máscara com os N bits de linha do tabuleiro
+static int simetria = SIMETRIA_NENHUMA; // Modo de redução por simetria
+static FILE *fpSaida = NULL;      // Destino da saída binária de soluções (NULL = apenas contagem)
+static unsigned char *bufferSaida; // Buffer da saída binária
+static size_t usadoSaida = 0;     // Bytes ocupados no buffer
+static int bitsPorLinha;          // Bits por índice de linha na saída binária
+static int bytesPorSolucao;       // Bytes ocupados por solução na saída binária
+static contagem_t (*kernelContagem)(uint64_t, uint64_t, uint64_t); // Motor de bits usado nas subárvores
+static int folhaIterativa = 0;    // Subárvores contadas pelo motor iterativo (-m iter)
+static int memoMin = 0, memoMax = 0; // Colunas restantes em que a tabela é consultada (0 = desativada)
+static EntradaMemo *tabelaMemo = NULL; // Tabela de memoização (endereçamento direto)
+static uint64_t mascaraMemo;      // Número de entradas - 1 (potência de 2)
+static long long acertosMemo = 0; // Consultas encontradas na tabela
+static long long falhasMemo = 0;  // Consultas recalculadas e gravadas na tabela
+
+// Instrumentação opcional da busca (compilar com -DINSTRUMENTACAO)
+// Sem a opção as macros não geram código e a busca não paga nenhum custo
+#ifdef INSTRUMENTACAO
+// Estatísticas da árvore de busca
+typedef struct{
+    long long nos[MAX_TAM_BITS + 1];   // Nós avaliados por profundidade (damas colocadas)
+    long long podas[MAX_TAM_BITS + 1]; // Linhas livres descartadas por ataque em cada profundidade
+} EstatisticasBusca;
+
+static EstatisticasBusca estatisticas;
+
+#define INSTR_NOS(prof, n) (estatisticas.nos[prof] += (n))
+#define INSTR_PODAS(prof, n) (estatisticas.podas[prof] += (n))
+#else
+#define INSTR_NOS(prof, n)
+#define INSTR_PODAS(prof, n)
+#endif
+
+// Registra um nó do motor de bits: a profundidade é o número de linhas ocupadas
+// e as podas são as linhas ainda livres mas atacadas por alguma diagonal
+#define INSTR_NO_BITS(linhas, diag1, diag2) \
+    INSTR_NOS(__builtin_popcountll(linhas), 1); \
+    INSTR_PODAS(__builtin_popcountll(linhas), __builtin_popcountll(~(linhas) & ((diag1) | (diag2)) & mascaraTabuleiro))
+
+// Converte uma contagem (64 ou 128 bits) para texto decimal
+char *formatarContagem(contagem_t valor, char *texto){
+    char inverso[48];
+    int n = 0;
+
+    do{
+        inverso[n++] = '0' + (int)(valor % 10);
+        valor /= 10;
+    }while(valor > 0);
+
+    for(int i = 0; i < n; i++){
+        texto[i] = inverso[n - 1 - i];
+    }
+    texto[n] = '\0';
+    return texto;
+}
 
 // Função que imprime uma solução encontrada
 void printSolution(int *board){
-    printf("Solução %d: ", nSolutions);
+    char texto[48];
+
+    printf("Solução %s: ", formatarContagem(nSolutions, texto));
     for(int col = 0; col < TamTabuleiro; col++){
         printf("(%d, %d) ", board[col], col);
     }
     printf("\n");
 }
 
+// Abre a saída binária de soluções e grava o cabeçalho ("-" usa a saída padrão)
+void abrirSaida(const char *arquivo){
+    CabecalhoSolucoes cab;
+
+    fpSaida = (strcmp(arquivo, "-") == 0) ? stdout : fopen(arquivo, "wb");
+    if(fpSaida == NULL){
+        perror("Erro ao abrir a saída de soluções");
+        exit(-1);
+    }
+    bufferSaida = (unsigned char *)malloc(TAM_BUFFER_SAIDA);
+
+    for(bitsPorLinha = 1; (1 << bitsPorLinha) < TamTabuleiro; bitsPorLinha++);
+    bytesPorSolucao = (TamTabuleiro * bitsPorLinha + 7) / 8;
+
+    memcpy(cab.magica, "NDSO", 4);
+    cab.tamanho = TamTabuleiro;
+    cab.bitsPorLinha = bitsPorLinha;
+    fwrite(&cab, sizeof(cab), 1, fpSaida);
+}
+
+// Descarrega o buffer da saída binária em um único bloco
+void descarregarSaida(){
+    fwrite(bufferSaida, 1, usadoSaida, fpSaida);
+    usadoSaida = 0;
+}
+
+// Empacota uma solução (linha de cada coluna) no buffer da saída binária
+void empacotarSolucao(int *board, int espelhar){
+    unsigned char *destino;
+    uint64_t acumulador = 0;
+    int nBits = 0;
+
+    if(usadoSaida + bytesPorSolucao > TAM_BUFFER_SAIDA){
+        descarregarSaida();
+    }
+    destino = bufferSaida + usadoSaida;
+    usadoSaida += bytesPorSolucao;
+
+    for(int col = 0; col < TamTabuleiro; col++){
+        uint64_t linha = espelhar ? TamTabuleiro - 1 - board[col] : board[col];
+
+        acumulador |= linha << nBits;
+        nBits += bitsPorLinha;
+        while(nBits >= 8){
+            *destino++ = acumulador & 0xFF;
+            acumulador >>= 8;
+            nBits -= 8;
+        }
+    }
+    if(nBits > 0){
+        *destino = acumulador & 0xFF;
+    }
+}
+
+// Grava uma solução encontrada; no modo espelho grava também sua reflexão
+void gravarSolucao(int *board){
+    empacotarSolucao(board, 0);
+    if(simetria == SIMETRIA_ESPELHO && TamTabuleiro > 1){
+        empacotarSolucao(board, 1);
+    }
+}
+
+// Descarrega o restante do buffer e fecha a saída binária
+void fecharSaida(){
+    descarregarSaida();
+    if(fpSaida == stdout){
+        fflush(fpSaida);
+    }
+    else{
+        fclose(fpSaida);
+    }
+    free(bufferSaida);
+}
+
 // Confere se a posição da dama é válida (1) ou inválida (0) antes de colocá-la
 int isSafe(int *board, int row, int col){
     int i, j;
@@ -47,10 +267,32 @@ int isSafe(int *board, int row, int col){
     return 1;
 }
 
+// Retorna o limite de linhas a explorar em uma coluna
+// No modo espelho a primeira coluna usa apenas a metade superior; se a dama
+// estiver na linha central (N ímpar), a segunda coluna é que é dividida ao meio
+int limiteLinhas(int *board, int col){
+    int meio = TamTabuleiro / 2;
+
+    if(simetria == SIMETRIA_NENHUMA || TamTabuleiro == 1){
+        return TamTabuleiro;
+    }
+    if(col == 0){
+        return (TamTabuleiro + 1) / 2;
+    }
+    if(col == 1 && TamTabuleiro % 2 == 1 && board[0] == meio){
+        return meio;
+    }
+    return TamTabuleiro;
+}
+
 // Percorre o tabuleiro colocando as damas em posições válidas
 void solveNQ(int *board, int col){
-    // Lê os valores da coluna atual até o final do tabuleiro
-    for(int i = 0; i < TamTabuleiro; i++){
+    int limite = limiteLinhas(board, col);
+
+    INSTR_NOS(col, 1);
+
+    // Lê os valores da coluna atual até o limite de exploração
+    for(int i = 0; i < limite; i++){
         // Confere se uma posição é válida
         if(isSafe(board, i, col)){
             // Atribui a posição da dama no tabuleiro
@@ -60,8 +302,13 @@ void solveNQ(int *board, int col){
             if(col == TamTabuleiro-1){ 
                 // Exibe as coordenadas da solução encontrada
                 //printSolution(board);
+                // Grava a solução na saída binária, se ativa
+                if(fpSaida != NULL){
+                    gravarSolucao(board);
+                }
                 // Contabiliza a solução
                 nSolutions++;
+                INSTR_NOS(TamTabuleiro, 1);
             }
             else{ 
                 // Copia o tabuleiro atual para um temporário
@@ -75,31 +322,963 @@ void solveNQ(int *board, int col){
                 free(nb);
             }
         }
+        else{
+            INSTR_PODAS(col, 1);
+        }
     }
 }
  
+// Conta as soluções guardando linhas e diagonais ocupadas como máscaras de bits
+// Cada bit livre em ~(linhas | diag1 | diag2) é uma linha válida na coluna atual
+contagem_t solveNQBits(uint64_t linhas, uint64_t diag1, uint64_t diag2){
+    INSTR_NO_BITS(linhas, diag1, diag2);
+
+    // Todas as linhas ocupadas: solução encontrada
+    if(linhas == mascaraTabuleiro){
+        return 1;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        // Extrai o bit menos significativo (linha livre de menor índice)
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        // Segue para a próxima coluna deslocando as diagonais
+        total += solveNQBits(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1);
+    }
+    return total;
+}
+
+// Gera o motor de bits especializado para um N fixo em tempo de compilação
+// A máscara do tabuleiro vira constante e as máscaras usam 32 bits; a entrada de 64 bits
+// descarta apenas bits de diagonal que já saíram do tabuleiro
+#define DEFINIR_KERNEL(N) \
+contagem_t solveNQBits##N(uint32_t linhas, uint32_t diag1, uint32_t diag2, int restantes){ \
+    const uint32_t mascara = (uint32_t)((1ULL << N) - 1); \
+    uint32_t livres = ~(linhas | diag1 | diag2) & mascara; \
+    INSTR_NO_BITS(linhas, diag1, diag2); \
+    if(restantes == 1){ \
+        INSTR_NOS(N, livres != 0); \
+        return livres != 0; \
+    } \
+    contagem_t total = 0; \
+    while(livres){ \
+        uint32_t bit = livres & -livres; \
+        livres ^= bit; \
+        total += solveNQBits##N(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, restantes - 1); \
+    } \
+    return total; \
+} \
+contagem_t kernelContagem##N(uint64_t linhas, uint64_t diag1, uint64_t diag2){ \
+    if(linhas == (1ULL << N) - 1){ \
+        INSTR_NOS(N, 1); \
+        return 1; \
+    } \
+    return solveNQBits##N((uint32_t)linhas, (uint32_t)diag1, (uint32_t)diag2, N - __builtin_popcountll(linhas)); \
+}
+
+// Tamanhos com motor especializado (MIN_TAM_ESPECIALIZADO a MAX_TAM_ESPECIALIZADO)
+#define LISTA_KERNELS(X) \
+    X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) X(18) \
+    X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32)
+
+LISTA_KERNELS(DEFINIR_KERNEL)
+
+// Tabela de despacho indexada por N
+#define ENTRADA_KERNEL(N) [N] = kernelContagem##N,
+static contagem_t (*const kernelsEspecializados[MAX_TAM_ESPECIALIZADO + 1])(uint64_t, uint64_t, uint64_t) = {
+    LISTA_KERNELS(ENTRADA_KERNEL)
+};
+
+// Versão iterativa do motor de bits: cada coluna ocupa um nível de uma pilha explícita
+// A coluna atual fica em registradores; a pilha (32 bytes por coluna) cabe no cache L1
+// e só é acessada ao descer ou voltar uma coluna, sem chamada de função por nó
+// Medido contra a recursão em N=15 a 18 (ComparacaoMotores.sh) não é mais rápida:
+// 5% à frente em N=16 e de 5% a 13% atrás nos demais; fica como alternativa (-m iter)
+contagem_t solveNQIter(uint64_t linhas, uint64_t diag1, uint64_t diag2){
+    NivelPilha pilha[MAX_TAM_BITS];
+    contagem_t total = 0;
+    int topo = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    INSTR_NO_BITS(linhas, diag1, diag2);
+    if(linhas == mascaraTabuleiro){
+        return 1;
+    }
+
+    for(;;){
+        // Coluna esgotada: volta para a anterior
+        if(livres == 0){
+            if(topo == 0){
+                break;
+            }
+            topo--;
+            linhas = pilha[topo].linhas;
+            diag1 = pilha[topo].diag1;
+            diag2 = pilha[topo].diag2;
+            livres = pilha[topo].livres;
+            continue;
+        }
+
+        // Extrai o bit menos significativo (linha livre de menor índice)
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        uint64_t l = linhas | bit;
+        uint64_t d1 = (diag1 | bit) << 1;
+        uint64_t d2 = (diag2 | bit) >> 1;
+        INSTR_NO_BITS(l, d1, d2);
+
+        // Última coluna preenchida: conta a solução sem empilhar
+        if(l == mascaraTabuleiro){
+            total++;
+            continue;
+        }
+
+        // Desce apenas se a próxima coluna possuir alguma linha livre
+        uint64_t proximas = ~(l | d1 | d2) & mascaraTabuleiro;
+        if(proximas){
+            pilha[topo].linhas = linhas;
+            pilha[topo].diag1 = diag1;
+            pilha[topo].diag2 = diag2;
+            pilha[topo].livres = livres;
+            topo++;
+
+            linhas = l;
+            diag1 = d1;
+            diag2 = d2;
+            livres = proximas;
+        }
+    }
+    return total;
+}
+
+// Variante do motor de bits que guarda a linha de cada coluna e grava as soluções
+contagem_t solveNQBitsSaida(uint64_t linhas, uint64_t diag1, uint64_t diag2, int col, int *board){
+    INSTR_NO_BITS(linhas, diag1, diag2);
+
+    if(linhas == mascaraTabuleiro){
+        gravarSolucao(board);
+        return 1;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        // Índice da linha livre escolhida
+        board[col] = __builtin_ctzll(bit);
+        total += solveNQBitsSaida(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, col + 1, board);
+    }
+    return total;
+}
+
+// Aloca a tabela de memoização com a maior potência de 2 de entradas que cabe em megabytes
+void iniciarMemo(long megabytes){
+    size_t entradas = 1;
+
+    while(2 * entradas * sizeof(EntradaMemo) <= (size_t)megabytes << 20){
+        entradas *= 2;
+    }
+    tabelaMemo = (EntradaMemo *)calloc(entradas, sizeof(EntradaMemo));
+    if(tabelaMemo == NULL){
+        fprintf(stdout, "Memória insuficiente para a tabela de memoização (%ld MB)\n", megabytes);
+        exit(-1);
+    }
+    mascaraMemo = entradas - 1;
+}
+
+// Espalha o estado (linhas e diagonais) pelos bits do índice da tabela
+uint64_t hashEstado(uint64_t linhas, uint64_t diag1, uint64_t diag2){
+    uint64_t h = linhas * 0x9E3779B97F4A7C15ULL ^ diag1 * 0xC2B2AE3D27D4EB4FULL ^ diag2 * 0x165667B19E3779F9ULL;
+    return h ^ (h >> 31);
+}
+
+// Motor de bits com memoização das subárvores dentro da janela de colunas restantes
+// Bits de diagonal que só atingiriam linhas já ocupadas são descartados da chave,
+// de modo que prefixos diferentes com o mesmo futuro compartilhem a entrada
+contagem_t solveNQBitsMemo(uint64_t linhas, uint64_t diag1, uint64_t diag2, int restantes){
+    EntradaMemo *e = NULL;
+
+    // Abaixo da janela a subárvore é contada diretamente
+    if(restantes < memoMin){
+        return folhaIterativa ? solveNQIter(linhas, diag1, diag2) : kernelContagem(linhas, diag1, diag2);
+    }
+    INSTR_NO_BITS(linhas, diag1, diag2);
+
+    if(restantes <= memoMax){
+        uint64_t livresFuturas = ~linhas & mascaraTabuleiro, alcance1 = 0, alcance2 = 0;
+
+        // A diagonal na linha r atinge a linha r+k (ou r-k) k colunas adiante
+        for(int k = 0; k < restantes; k++){
+            alcance1 |= livresFuturas >> k;
+            alcance2 |= livresFuturas << k;
+        }
+        diag1 &= alcance1;
+        diag2 &= alcance2;
+
+        e = &tabelaMemo[hashEstado(linhas, diag1, diag2) & mascaraMemo];
+        if(e->linhas == linhas && e->diag1 == diag1 && e->diag2 == diag2){
+            acertosMemo++;
+            return e->contagem;
+        }
+        falhasMemo++;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        total += solveNQBitsMemo(linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, restantes - 1);
+    }
+
+    // Substitui a entrada anterior do mesmo índice
+    if(e != NULL){
+        e->linhas = linhas;
+        e->diag1 = diag1;
+        e->diag2 = diag2;
+        e->contagem = total;
+    }
+    return total;
+}
+
+// Conta a subárvore a partir de uma coluna, gravando as soluções se a saída estiver ativa
+contagem_t contarSubarvore(uint64_t linhas, uint64_t diag1, uint64_t diag2, int col, int *board){
+    if(fpSaida != NULL){
+        return solveNQBitsSaida(linhas, diag1, diag2, col, board);
+    }
+    if(tabelaMemo != NULL){
+        return solveNQBitsMemo(linhas, diag1, diag2, TamTabuleiro - col);
+    }
+    if(folhaIterativa){
+        return solveNQIter(linhas, diag1, diag2);
+    }
+    return kernelContagem(linhas, diag1, diag2);
+}
+
+// Conta apenas a metade espelhada da árvore com o motor de bits
+// Metade superior da primeira coluna; na linha central, metade superior da segunda
+contagem_t solveNQBitsEspelho(int *board){
+    contagem_t total = 0;
+    int meio = TamTabuleiro / 2;
+
+    // Tabuleiro 1x1 não possui metade espelhada
+    if(TamTabuleiro == 1){
+        return 1;
+    }
+
+    for(int i = 0; i < meio; i++){
+        uint64_t bit = 1ULL << i;
+        board[0] = i;
+        total += contarSubarvore(bit, bit << 1, bit >> 1, 1, board);
+    }
+
+    // Linha central da primeira coluna (N ímpar)
+    if(TamTabuleiro % 2 == 1){
+        uint64_t centro = 1ULL << meio;
+        uint64_t diag1 = centro << 1, diag2 = centro >> 1;
+        uint64_t livres = ~(centro | diag1 | diag2) & ((1ULL << meio) - 1);
+
+        board[0] = meio;
+        while(livres){
+            uint64_t bit = livres & -livres;
+            livres ^= bit;
+            board[1] = __builtin_ctzll(bit);
+            total += contarSubarvore(centro | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, 2, board);
+        }
+    }
+
+    // Cada solução explorada possui exatamente uma reflexão fora da metade
+    return 2 * total;
+}
+
+// Confere se a solução completa é a representante da sua classe de simetria
+// e a contabiliza conforme o número de variantes distintas (2, 4 ou 8)
+void checkSimetria(BuscaSimetria *s){
+    uint64_t *board = s->board;
+    int ultima = TamTabuleiro - 1;
+    int own, you;
+    uint64_t bit, ptn;
+
+    // Rotação de 90 graus
+    if(board[s->bound2] == 1){
+        for(ptn = 2, own = 1; own <= ultima; own++, ptn <<= 1){
+            bit = 1;
+            for(you = ultima; board[you] != ptn && board[own] >= bit; you--){
+                bit <<= 1;
+            }
+            if(board[own] > bit){
+                return;
+            }
+            if(board[own] < bit){
+                break;
+            }
+        }
+        // Solução igual à sua rotação de 90 graus
+        if(own > ultima){
+            s->count2++;
+            return;
+        }
+    }
+
+    // Rotação de 180 graus
+    if(board[ultima] == s->endbit){
+        for(you = ultima - 1, own = 1; own <= ultima; own++, you--){
+            bit = 1;
+            for(ptn = s->topbit; ptn != board[you] && board[own] >= bit; ptn >>= 1){
+                bit <<= 1;
+            }
+            if(board[own] > bit){
+                return;
+            }
+            if(board[own] < bit){
+                break;
+            }
+        }
+        // Solução igual à sua rotação de 180 graus
+        if(own > ultima){
+            s->count4++;
+            return;
+        }
+    }
+
+    // Rotação de 270 graus
+    if(board[s->bound1] == s->topbit){
+        for(ptn = s->topbit >> 1, own = 1; own <= ultima; own++, ptn >>= 1){
+            bit = 1;
+            for(you = 0; board[you] != ptn && board[own] >= bit; you++){
+                bit <<= 1;
+            }
+            if(board[own] > bit){
+                return;
+            }
+            if(board[own] < bit){
+                break;
+            }
+        }
+    }
+    s->count8++;
+}
+
+// Busca com a primeira dama no canto: nenhuma solução é simétrica a si mesma
+void backtrackCanto(BuscaSimetria *s, int col, uint64_t diag1, uint64_t linhas, uint64_t diag2){
+    uint64_t livres = mascaraTabuleiro & ~(diag1 | linhas | diag2);
+
+    INSTR_NO_BITS(linhas, diag1, diag2);
+    if(col == TamTabuleiro - 1){
+        if(livres){
+            INSTR_NOS(TamTabuleiro, 1);
+            s->board[col] = livres;
+            s->count8++;
+        }
+        return;
+    }
+
+    // Elimina a reflexão pela diagonal principal
+    if(col < s->bound1){
+        livres &= ~2ULL;
+    }
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        s->board[col] = bit;
+        backtrackCanto(s, col + 1, (diag1 | bit) << 1, linhas | bit, (diag2 | bit) >> 1);
+    }
+}
+
+// Busca com a primeira dama fora do canto, podando pelas bordas do tabuleiro
+void backtrackBorda(BuscaSimetria *s, int col, uint64_t diag1, uint64_t linhas, uint64_t diag2){
+    uint64_t livres = mascaraTabuleiro & ~(diag1 | linhas | diag2);
+
+    INSTR_NO_BITS(linhas, diag1, diag2);
+    if(col == TamTabuleiro - 1){
+        if(livres && !(livres & s->lastmask)){
+            INSTR_NOS(TamTabuleiro, 1);
+            s->board[col] = livres;
+            checkSimetria(s);
+        }
+        return;
+    }
+
+    if(col < s->bound1){
+        livres &= ~s->sidemask;
+    }
+    else if(col == s->bound2){
+        if(!(linhas & s->sidemask)){
+            return;
+        }
+        if((linhas & s->sidemask) != s->sidemask){
+            livres &= s->sidemask;
+        }
+    }
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+        s->board[col] = bit;
+        backtrackBorda(s, col + 1, (diag1 | bit) << 1, linhas | bit, (diag2 | bit) >> 1);
+    }
+}
+
+// Conta as soluções pelas classes de simetria do grupo D4
+// Total = 2*count2 + 4*count4 + 8*count8 e fundamentais = count2 + count4 + count8
+void solveNQClasses(){
+    BuscaSimetria s;
+    uint64_t bit;
+    int ultima = TamTabuleiro - 1;
+
+    memset(&s, 0, sizeof(s));
+    s.topbit = 1ULL << ultima;
+
+    // Primeira dama no canto
+    s.board[0] = 1;
+    for(s.bound1 = 2; s.bound1 < ultima; s.bound1++){
+        s.board[1] = bit = 1ULL << s.bound1;
+        backtrackCanto(&s, 2, (2 | bit) << 1, 1 | bit, bit >> 1);
+    }
+
+    // Primeira dama fora do canto
+    s.sidemask = s.lastmask = s.topbit | 1;
+    s.endbit = s.topbit >> 1;
+    for(s.bound1 = 1, s.bound2 = TamTabuleiro - 2; s.bound1 < s.bound2; s.bound1++, s.bound2--){
+        s.board[0] = bit = 1ULL << s.bound1;
+        backtrackBorda(&s, 1, bit << 1, bit, bit >> 1);
+        s.lastmask |= s.lastmask >> 1 | s.lastmask << 1;
+        s.endbit >>= 1;
+    }
+
+    nSolutions = 2 * s.count2 + 4 * s.count4 + 8 * s.count8;
+    nFundamentais = s.count2 + s.count4 + s.count8;
+}
+
+// Interpreta uma configuração inicial: linha da dama em cada coluna, '.' ou '-' para livre
+// Exemplo para N = 6: "1,.,.,.,.,4". Também calcula as linhas atacadas pelas damas fixas
+void lerConfiguracao(const char *texto, Configuracao *c){
+    const char *p = texto;
+    int col = 0;
+
+    c->valida = 0;
+    while(*p != '\0'){
+        char *fim;
+        long linha;
+
+        // Separadores entre as colunas
+        if(*p == ',' || *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'){
+            p++;
+            continue;
+        }
+        if(col >= TamTabuleiro){
+            return;
+        }
+        if(*p == '.' || *p == '-'){
+            c->fixa[col++] = -1;
+            p++;
+            continue;
+        }
+        linha = strtol(p, &fim, 10);
+        if(fim == p || linha < 0 || linha >= TamTabuleiro){
+            return;
+        }
+        c->fixa[col++] = linha;
+        p = fim;
+    }
+    if(col != TamTabuleiro){
+        return;
+    }
+
+    // Linhas e diagonais atacadas por cada dama fixa, projetadas em todas as colunas
+    memset(c->proibidas, 0, sizeof(c->proibidas));
+    for(int f = 0; f < TamTabuleiro; f++){
+        int r = c->fixa[f];
+
+        if(r < 0){
+            continue;
+        }
+        for(int j = 0; j < TamTabuleiro; j++){
+            int d = (j > f) ? j - f : f - j;
+
+            // Outra dama fixa atacada por esta: configuração sem completamento válido
+            if(j != f && c->fixa[j] >= 0 && (c->fixa[j] == r || c->fixa[j] == r + d || c->fixa[j] == r - d)){
+                return;
+            }
+            c->proibidas[j] |= 1ULL << r;
+            if(r + d < TamTabuleiro){
+                c->proibidas[j] |= 1ULL << (r + d);
+            }
+            if(r - d >= 0){
+                c->proibidas[j] |= 1ULL << (r - d);
+            }
+        }
+    }
+    c->valida = 1;
+}
+
+// Lê as configurações de um arquivo (uma por linha, '-' para a entrada padrão)
+// Linhas vazias ou iniciadas por '#' são ignoradas
+Configuracao *lerConfiguracoes(const char *arquivo, int *quantas){
+    Configuracao *v = NULL;
+    int capacidade = 0;
+    char linha[1024];
+    FILE *fp = (strcmp(arquivo, "-") == 0) ? stdin : fopen(arquivo, "r");
+
+    if(fp == NULL){
+        perror("Erro ao abrir o arquivo de configurações");
+        exit(-1);
+    }
+
+    *quantas = 0;
+    while(fgets(linha, sizeof(linha), fp) != NULL){
+        if(linha[0] == '#' || linha[strspn(linha, " \t\r\n")] == '\0'){
+            continue;
+        }
+        if(*quantas == capacidade){
+            capacidade = capacidade ? 2 * capacidade : 64;
+            v = (Configuracao *)realloc(v, capacidade * sizeof(Configuracao));
+        }
+        lerConfiguracao(linha, &v[(*quantas)++]);
+    }
+    if(fp != stdin){
+        fclose(fp);
+    }
+    return v;
+}
+
+// Conta os completamentos de uma configuração com as máscaras do motor de bits
+// As máscaras dinâmicas guardam apenas as damas das colunas livres: as fixas já
+// entram pelas linhas proibidas, então suas colunas são puladas sem nova busca
+// No modo encontrar a busca para no primeiro completamento, deixado em board
+contagem_t completarConfiguracao(const Configuracao *c, uint64_t linhas, uint64_t diag1, uint64_t diag2,
+                                 int col, int *board, int encontrar){
+    // Pula as colunas fixas, apenas deslocando as diagonais
+    while(col < TamTabuleiro && c->fixa[col] >= 0){
+        board[col] = c->fixa[col];
+        diag1 <<= 1;
+        diag2 >>= 1;
+        col++;
+    }
+    if(col == TamTabuleiro){
+        if(fpSaida != NULL){
+            gravarSolucao(board);
+        }
+        return 1;
+    }
+
+    contagem_t total = 0;
+    uint64_t livres = ~(linhas | diag1 | diag2 | c->proibidas[col]) & mascaraTabuleiro;
+
+    while(livres){
+        uint64_t bit = livres & -livres;
+        livres ^= bit;
+
+        board[col] = __builtin_ctzll(bit);
+        total += completarConfiguracao(c, linhas | bit, (diag1 | bit) << 1, (diag2 | bit) >> 1, col + 1, board, encontrar);
+        if(encontrar && total > 0){
+            break;
+        }
+    }
+    return total;
+}
+
+// Modo de completamento: resolve cada configuração inicial e exibe o resultado de cada uma
+// O tempo medido cobre apenas a busca, sem a leitura das configurações e a impressão
+void resolverConfiguracoes(const char *unica, const char *arquivo, int encontrar, FILE *relatorio){
+    Configuracao *v;
+    contagem_t *resultados;
+    int *completos;
+    int quantas, invalidas = 0;
+    char texto[48];
+    struct timeval start, stop;
+
+    if(unica != NULL){
+        v = (Configuracao *)malloc(sizeof(Configuracao));
+        quantas = 1;
+        lerConfiguracao(unica, v);
+    }
+    else{
+        v = lerConfiguracoes(arquivo, &quantas);
+    }
+    resultados = (contagem_t *)malloc((quantas + 1) * sizeof(contagem_t));
+    completos = (int *)malloc((quantas + 1) * TamTabuleiro * sizeof(int));
+
+    // Obtém o tempo inicial
+    gettimeofday(&start, NULL);
+
+    for(int k = 0; k < quantas; k++){
+        resultados[k] = 0;
+        if(v[k].valida){
+            resultados[k] = completarConfiguracao(&v[k], 0, 0, 0, 0, &completos[k * TamTabuleiro], encontrar);
+        }
+    }
+
+    // Obtém o tempo final
+    gettimeofday(&stop, NULL);
+    double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
+
+    // Resultado de cada configuração, na ordem de entrada
+    nSolutions = 0;
+    for(int k = 0; k < quantas; k++){
+        nSolutions += resultados[k];
+        if(!v[k].valida){
+            invalidas++;
+            fprintf(relatorio, "Configuração %d: inválida\n", k + 1);
+        }
+        else if(!encontrar){
+            fprintf(relatorio, "Configuração %d: %s completamentos\n", k + 1, formatarContagem(resultados[k], texto));
+        }
+        else if(resultados[k] == 0){
+            fprintf(relatorio, "Configuração %d: sem completamento\n", k + 1);
+        }
+        else{
+            fprintf(relatorio, "Configuração %d: ", k + 1);
+            for(int col = 0; col < TamTabuleiro; col++){
+                fprintf(relatorio, "(%d, %d) ", completos[k * TamTabuleiro + col], col);
+            }
+            fprintf(relatorio, "\n");
+        }
+    }
+
+    fprintf(relatorio, "Número total de soluções: %s\n", formatarContagem(nSolutions, texto));
+    fprintf(relatorio, "Configurações processadas: %d (inválidas: %d)\n", quantas, invalidas);
+    fprintf(relatorio, "Tempo decorrido = %g ms\n", t);
+
+    free(v);
+    free(resultados);
+    free(completos);
+}
+
+#ifdef INSTRUMENTACAO
+// Exibe os nós avaliados e as podas por profundidade e a vazão da busca
+void relatarInstrumentacao(FILE *relatorio, double ms){
+    long long nos = 0, podas = 0;
+
+    fprintf(relatorio, "Instrumentação da busca (profundidade = damas colocadas):\n");
+    fprintf(relatorio, "  %5s %18s %18s\n", "prof", "nos", "podas");
+    for(int p = 0; p <= TamTabuleiro; p++){
+        if(estatisticas.nos[p] == 0 && estatisticas.podas[p] == 0){
+            continue;
+        }
+        fprintf(relatorio, "  %5d %18lld %18lld\n", p, estatisticas.nos[p], estatisticas.podas[p]);
+        nos += estatisticas.nos[p];
+        podas += estatisticas.podas[p];
+    }
+    fprintf(relatorio, "Nós avaliados: %lld, podas: %lld (%.4g nós/s)\n", nos, podas, ms > 0 ? nos / (ms / 1000.0) : 0.0);
+}
+#endif
+
+// Define o tamanho do tabuleiro, a máscara das linhas e o motor especializado para N
+void configurarTabuleiro(int n, int kernelGenerico){
+    TamTabuleiro = n;
+    mascaraTabuleiro = (n == 64) ? ~0ULL : (1ULL << n) - 1;
+
+    // Motor de bits especializado para o N pedido (-G força o motor genérico)
+    kernelContagem = solveNQBits;
+    if(!kernelGenerico && n >= MIN_TAM_ESPECIALIZADO && n <= MAX_TAM_ESPECIALIZADO){
+        kernelContagem = kernelsEspecializados[n];
+    }
+}
+
+// Resolve o problema das N-Damas com o motor e o modo de simetria escolhidos
+void resolverBusca(int motor, int *board){
+    nSolutions = 0;
+    if(simetria == SIMETRIA_CLASSES){
+        solveNQClasses();
+    }
+    else if(motor == MOTOR_BITS && simetria == SIMETRIA_ESPELHO){
+        nSolutions = solveNQBitsEspelho(board);
+    }
+    else if(motor == MOTOR_BITS){
+        nSolutions = contarSubarvore(0, 0, 0, 0, board);
+    }
+    else{
+        solveNQ(board,0);
+
+        // Cada solução explorada possui exatamente uma reflexão fora da metade
+        if(simetria == SIMETRIA_ESPELHO && TamTabuleiro > 1){
+            nSolutions *= 2;
+        }
+    }
+}
+
+// Interpreta a lista de tamanhos do modo lote: valores e intervalos separados por vírgula
+// Exemplo: "8-15" ou "8,10,12-14". Devolve a quantidade de tamanhos (0 se inválida)
+int lerLote(const char *texto, int *tamanhos){
+    int quantos = 0;
+    const char *p = texto;
+
+    while(*p != '\0'){
+        char *fim;
+        long inicio = strtol(p, &fim, 10), final;
+
+        if(fim == p){
+            return 0;
+        }
+        final = inicio;
+        p = fim;
+        if(*p == '-'){
+            final = strtol(p + 1, &fim, 10);
+            if(fim == p + 1 || final < inicio){
+                return 0;
+            }
+            p = fim;
+        }
+        for(long n = inicio; n <= final; n++){
+            if(quantos == MAX_LOTE){
+                return 0;
+            }
+            tamanhos[quantos++] = n;
+        }
+        if(*p == ','){
+            p++;
+        }
+        else if(*p != '\0'){
+            return 0;
+        }
+    }
+    return quantos;
+}
+
+// Executa todas as contagens do lote no mesmo processo, uma linha CSV por repetição
+void executarLote(int *tamanhos, int quantos, int repeticoes, int motor, int kernelGenerico, int *board, FILE *relatorio){
+    struct timeval start, stop;
+    char texto[48], textoFund[48];
+
+    fprintf(relatorio, "n,repeticao,solucoes,fundamentais,tempo_ms\n");
+    for(int k = 0; k < quantos; k++){
+        configurarTabuleiro(tamanhos[k], kernelGenerico);
+        for(int r = 1; r <= repeticoes; r++){
+            gettimeofday(&start, NULL);
+            resolverBusca(motor, board);
+            gettimeofday(&stop, NULL);
+
+            double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
+            fprintf(relatorio, "%d,%d,%s,%s,%.6f\n", TamTabuleiro, r, formatarContagem(nSolutions, texto),
+                    formatarContagem(nFundamentais, textoFund), t);
+        }
+    }
+}
+
 // Função principal que recebe N de entrada e resolve o problema medindo o tempo de cada execução
 int main(int argc, char *argv[]){
     int i, *board;
+    int motor = MOTOR_ORIGINAL;
+    char *arquivoSaida = NULL;
+    char *configuracao = NULL, *arquivoConfiguracoes = NULL;
+    int encontrar = 0;
+    int kernelGenerico = 0;
+    long memoMB = MEMO_MB_PADRAO;
+    int tamanhos[MAX_LOTE], nLote = 0, repeticoes = 1;
+    char texto[48];
+    FILE *relatorio = stdout;
     struct timeval start, stop;
 
     // Verifica se o valor de N foi incluído na linha de comando
     if(argc <=1){
         fprintf(stdout, "É necessário especificar o tamanho do tabuleiro\n");
+        fprintf(stdout, "Uso: %s N [-m original|bits|iter] [-s espelho|classes] [-o solucoes.bin|-]" USO_MEMO " [-G]\n", argv[0]);
+        fprintf(stdout, "     %s N -p configuracao | -P arquivo [-e] [-o solucoes.bin|-]\n", argv[0]);
+        fprintf(stdout, "     %s N1-N2,N3,... [-R repeticoes] [-m original|bits|iter] [-s espelho|classes] [-G] (lote em CSV)\n", argv[0]);
         exit(-1);
     }
 
     // Recebe o tamnho do tabuleiro com base na entrada (argv[1])
     TamTabuleiro = strtol(argv[1], NULL, 10);
 
+    // Uma lista ou intervalo de tamanhos ativa o modo lote
+    // Os limites são conferidos com o maior N da lista e o modo classes com cada N
+    if(strpbrk(argv[1], ",-") != NULL){
+        nLote = lerLote(argv[1], tamanhos);
+        if(nLote == 0){
+            fprintf(stdout, "Lista de tamanhos inválida: %s\n", argv[1]);
+            exit(-1);
+        }
+        TamTabuleiro = tamanhos[0];
+        for(i = 1; i < nLote; i++){
+            if(tamanhos[i] > TamTabuleiro){
+                TamTabuleiro = tamanhos[i];
+            }
+        }
+    }
+
+    // Opções adicionais após o tamanho do tabuleiro
+    for(i = 2; i < argc; i++){
+        if(strcmp(argv[i], "-m") == 0 && i + 1 < argc){
+            i++;
+            if(strcmp(argv[i], "original") == 0){
+                motor = MOTOR_ORIGINAL;
+            }
+            else if(strcmp(argv[i], "bits") == 0){
+                motor = MOTOR_BITS;
+            }
+            else if(strcmp(argv[i], "iter") == 0){
+                motor = MOTOR_ITER;
+            }
+            else{
+                fprintf(stdout, "Motor desconhecido: %s\n", argv[i]);
+                exit(-1);
+            }
+        }
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc){
+            i++;
+            if(strcmp(argv[i], "espelho") == 0){
+                simetria = SIMETRIA_ESPELHO;
+            }
+            else if(strcmp(argv[i], "classes") == 0){
+                simetria = SIMETRIA_CLASSES;
+            }
+            else{
+                fprintf(stdout, "Modo de simetria desconhecido: %s\n", argv[i]);
+                exit(-1);
+            }
+        }
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc){
+            arquivoSaida = argv[++i];
+        }
+        else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc){
+            configuracao = argv[++i];
+        }
+        else if(strcmp(argv[i], "-P") == 0 && i + 1 < argc){
+            arquivoConfiguracoes = argv[++i];
+        }
+        else if(strcmp(argv[i], "-e") == 0){
+            encontrar = 1;
+        }
+#ifdef MEMOIZACAO
+        else if(strcmp(argv[i], "-M") == 0 && i + 1 < argc){
+            // Janela de colunas restantes: apenas o limite superior fixa uma única profundidade
+            i++;
+            if(sscanf(argv[i], "%d:%d", &memoMax, &memoMin) < 2){
+                memoMin = memoMax;
+            }
+        }
+        else if(strcmp(argv[i], "-H") == 0 && i + 1 < argc){
+            memoMB = strtol(argv[++i], NULL, 10);
+        }
+#endif
+        else if(strcmp(argv[i], "-G") == 0){
+            kernelGenerico = 1;
+        }
+        else if(strcmp(argv[i], "-R") == 0 && i + 1 < argc){
+            repeticoes = strtol(argv[++i], NULL, 10);
+        }
+        else{
+            fprintf(stdout, "Opção desconhecida: %s\n", argv[i]);
+            exit(-1);
+        }
+    }
+
+    // O motor iterativo substitui apenas a contagem das subárvores do motor de bits
+    if(motor == MOTOR_ITER){
+        folhaIterativa = 1;
+        motor = MOTOR_BITS;
+    }
+
+    // Verifica se o tabuleiro cabe nos limites do motor escolhido
+    if(TamTabuleiro < 1 || (motor == MOTOR_BITS && TamTabuleiro > MAX_TAM_BITS)){
+        fprintf(stdout, "Tamanho de tabuleiro inválido: %d\n", TamTabuleiro);
+        exit(-1);
+    }
+
+#ifdef INSTRUMENTACAO
+    // As estatísticas guardam uma posição por profundidade
+    if(TamTabuleiro > MAX_TAM_BITS){
+        fprintf(stdout, "A instrumentação aceita N <= %d\n", MAX_TAM_BITS);
+        exit(-1);
+    }
+#endif
+
+    // O lote conta tabuleiros completos em sequência, sem arquivos auxiliares
+    if(nLote > 0){
+        for(i = 0; i < nLote; i++){
+            if(tamanhos[i] < 1 || (simetria == SIMETRIA_CLASSES && tamanhos[i] < 4)){
+                fprintf(stdout, "Tamanho de tabuleiro inválido no lote: %d\n", tamanhos[i]);
+                exit(-1);
+            }
+        }
+        if(repeticoes < 1 || arquivoSaida != NULL || configuracao != NULL || arquivoConfiguracoes != NULL || memoMax > 0){
+            fprintf(stdout, "O modo lote exige repetições >= 1 e não usa saída, completamento ou memoização\n");
+            exit(-1);
+        }
+    }
+
+    // A classificação por simetrias depende das máscaras do motor de bits
+    if(simetria == SIMETRIA_CLASSES && (motor != MOTOR_BITS || TamTabuleiro < 4)){
+        fprintf(stdout, "O modo classes exige o motor de bits e N >= 4\n");
+        exit(-1);
+    }
+
+    // O completamento usa as máscaras do motor de bits e percorre a árvore inteira
+    if((configuracao != NULL || arquivoConfiguracoes != NULL) &&
+       (TamTabuleiro > MAX_TAM_BITS || simetria != SIMETRIA_NENHUMA)){
+        fprintf(stdout, "O modo de completamento exige N <= %d e não usa simetria\n", MAX_TAM_BITS);
+        exit(-1);
+    }
+
+    // A memoização guarda apenas contagens das subárvores do motor de bits
+    if(memoMax > 0){
+        if(motor != MOTOR_BITS || simetria == SIMETRIA_CLASSES || arquivoSaida != NULL ||
+           configuracao != NULL || arquivoConfiguracoes != NULL){
+            fprintf(stdout, "A memoização exige o motor de bits, sem o modo classes, a saída de soluções ou o completamento\n");
+            exit(-1);
+        }
+        if(memoMin < MEMO_RESTANTES_MIN || memoMin > memoMax || memoMax >= TamTabuleiro || memoMB < 1){
+            fprintf(stdout, "Janela de memoização inválida: %d:%d (colunas restantes entre %d e N-1)\n",
+                    memoMax, memoMin, MEMO_RESTANTES_MIN);
+            exit(-1);
+        }
+        iniciarMemo(memoMB);
+    }
+
+    // A saída binária enumera todas as soluções (o modo classes só visita as fundamentais)
+    if(arquivoSaida != NULL){
+        if(simetria == SIMETRIA_CLASSES){
+            fprintf(stdout, "A saída de soluções não é compatível com o modo classes\n");
+            exit(-1);
+        }
+        abrirSaida(arquivoSaida);
+
+        // Com as soluções na saída padrão, o relatório segue pela saída de erro
+        if(fpSaida == stdout){
+            relatorio = stderr;
+        }
+    }
+    configurarTabuleiro(TamTabuleiro, kernelGenerico);
+
+    // Modo de completamento a partir de configurações iniciais
+    if(configuracao != NULL || arquivoConfiguracoes != NULL){
+        resolverConfiguracoes(configuracao, arquivoConfiguracoes, encontrar, relatorio);
+        if(fpSaida != NULL){
+            fecharSaida();
+        }
+        return 0;
+    }
+
     // Alocação dinâmica do tabuleiro
     board = (int *)malloc(TamTabuleiro*sizeof(int));
 
+    // Modo lote: todas as contagens no mesmo processo (o tabuleiro comporta o maior N)
+    if(nLote > 0){
+        executarLote(tamanhos, nLote, repeticoes, motor, kernelGenerico, board, relatorio);
+        free(board);
+        return 0;
+    }
+
     // Obtém o tempo inicial
     gettimeofday(&start, NULL);
  
     // Resolve o problema das N-Damas percorrendo todas as colunas
-    solveNQ(board,0);
+    resolverBusca(motor, board);
+
+    // Descarrega as soluções ainda no buffer antes de medir o tempo
+    if(fpSaida != NULL){
+        fecharSaida();
+    }
   
     // Obtém o tempo final
     gettimeofday(&stop, NULL); 
@@ -108,11 +1287,25 @@ int main(int argc, char *argv[]){
     double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
 
     // Exibe o total de soluções e o tempo decorrido
-    fprintf(stdout, "Número total de soluções: %d\n", nSolutions); 
-    fprintf(stdout, "Tempo decorrido = %g ms\n", t);
+    fprintf(relatorio, "Número total de soluções: %s\n", formatarContagem(nSolutions, texto)); 
+    if(simetria == SIMETRIA_CLASSES){
+        fprintf(relatorio, "Soluções fundamentais (únicas): %s\n", formatarContagem(nFundamentais, texto));
+    }
+    if(tabelaMemo != NULL){
+        long long consultas = acertosMemo + falhasMemo;
+        fprintf(relatorio, "Memoização: %d a %d colunas restantes, %llu entradas (%zu MB)\n", memoMin, memoMax,
+                (unsigned long long)mascaraMemo + 1, ((mascaraMemo + 1) * sizeof(EntradaMemo)) >> 20);
+        fprintf(relatorio, "Memoização: %lld acertos, %lld falhas (taxa de acerto %.2f%%)\n", acertosMemo, falhasMemo,
+                consultas > 0 ? 100.0 * acertosMemo / consultas : 0.0);
+    }
+#ifdef INSTRUMENTACAO
+    relatarInstrumentacao(relatorio, t);
+#endif
+    fprintf(relatorio, "Tempo decorrido = %g ms\n", t);
 
-    // Libera o tabuleiro
+    // Libera o tabuleiro e a tabela de memoização
     free(board);
+    free(tabelaMemo);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# Compara os operadores de cruzamento do algoritmo genético (-x corte, ox, pmx e cx)
+# Cada operador roda com as mesmas sementes e o mesmo limite de gerações (sem parada por estagnação)
+# Exibe o tempo médio por geração (relógio de parede), as execuções que encontraram solução
+# e a geração média da solução entre elas
+# Uso: ./ComparacaoCruzamentos.sh [programa] [repetições] [gerações] [população] [N...]
+# Exemplo: ./ComparacaoCruzamentos.sh ./ndgp 5 200 2000 100 1000 3000
+PROGRAMA=${1:-./ndgs}
+REPETICOES=${2:-5}
+GERACOES=${3:-200}
+POPULACAO=${4:-2000}
+TAMANHOS=${*:5}
+TAMANHOS=${TAMANHOS:-"100 1000"}
+
+printf "%6s %8s %16s %10s %14s\n" "N" "operador" "ms/geração" "soluções" "geração média"
+
+for x in $TAMANHOS; do
+    for operador in corte ox pmx cx; do
+        ARQUIVO_SAIDA="${operador}n${x}.txt"
+        > "$ARQUIVO_SAIDA"
+
+        for i in $(seq 1 $REPETICOES); do
+            INICIO=$(date +%s%N)
+            "$PROGRAMA" "${x}" -p "$POPULACAO" -g "$GERACOES" -e "$GERACOES" -x "$operador" --seed "$i" > saida.tmp
+            FIM=$(date +%s%N)
+
+            # Gerações executadas: a da solução ou o limite
+            GERACAO=$(awk -v g="$GERACOES" '/^Solucao na Geracao/ { sub("!", "", $4); g = $4 + 1 } END { print g }' saida.tmp)
+            SOLUCAO=$(grep -c "^Solucao na Geracao" saida.tmp)
+            echo "$(( (FIM - INICIO) / 1000 )) $GERACAO $SOLUCAO" >> "$ARQUIVO_SAIDA"
+        done
+        rm -f saida.tmp
+
+        # Colunas: microssegundos da execução, gerações executadas e solução encontrada (0 ou 1)
+        awk -v x="$x" -v op="$operador" '{ us += $1; g += $2; s += $3; if($3) gs += $2 - 1 }
+            END { printf "%6d %8s %16.3f %10d %14s\n", x, op, us / g / 1000.0, s, s ? sprintf("%.1f", gs / s) : "-" }' "$ARQUIVO_SAIDA"
+    done
+done
@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Compara o algoritmo genético puro (-l 0) com o passo memético de busca local (-l passos)
+# Cada configuração roda com as mesmas sementes e os parâmetros padrão de parada
+# Exibe as execuções que encontraram solução, a geração e o tempo médios até a solução
+# e o tempo total de parede de todas as execuções (inclui as que param sem solução)
+# Uso: ./ComparacaoMemetico.sh [programa] [repetições] [população] [passos...] -- [N...]
+# Exemplo: ./ComparacaoMemetico.sh ./ndgp 10 1000 0 5 20 -- 50 100
+PROGRAMA=${1:-./ndgs}
+REPETICOES=${2:-10}
+POPULACAO=${3:-1000}
+shift $(( $# < 3 ? $# : 3 ))
+PASSOS=""
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+    PASSOS="$PASSOS $1"
+    shift
+done
+[ $# -gt 0 ] && shift
+TAMANHOS=${*:-"50 100"}
+PASSOS=${PASSOS:-"0 5 20"}
+
+printf "%6s %8s %10s %14s %14s %14s\n" "N" "passos" "soluções" "geração média" "tempo médio" "tempo total"
+
+for x in $TAMANHOS; do
+    for passos in $PASSOS; do
+        ARQUIVO_SAIDA="memeticon${x}l${passos}.txt"
+        > "$ARQUIVO_SAIDA"
+
+        INICIO=$(date +%s%N)
+        for i in $(seq 1 $REPETICOES); do
+            "$PROGRAMA" "${x}" -p "$POPULACAO" -l "$passos" --seed "$i" >> "$ARQUIVO_SAIDA"
+        done
+        FIM=$(date +%s%N)
+
+        # Linhas "Solucao na Geracao X!" e "Tempo decorrido = X ms" das execuções com solução
+        awk -v x="$x" -v l="$passos" -v total="$(( (FIM - INICIO) / 1000000 ))" '
+            /^Solucao na Geracao/ { sub("!", "", $4); g += $4; s++ }
+            /^Tempo/ { t += $4 }
+            END { printf "%6d %8d %10d %14s %14s %12.3f s\n", x, l, s, s ? sprintf("%.1f", g / s) : "-",
+                  s ? sprintf("%.3f ms", t / s) : "-", total / 1000.0 }' "$ARQUIVO_SAIDA"
+    done
+done
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+# Compara o motor de bits recursivo (-m bits) com o iterativo de pilha explícita (-m iter)
+# Razão iter/bits acima de 1 indica o motor iterativo mais lento
+# Uso: ./ComparacaoMotores.sh [programa] [repetições] [N inicial] [N final]
+# Exemplo: ./ComparacaoMotores.sh ./ndbp 10 8 18
+PROGRAMA=${1:-./ndbs}
+REPETICOES=${2:-10}
+N_INICIAL=${3:-8}
+N_FINAL=${4:-18}
+
+printf "%4s %16s %16s %10s\n" "N" "bits (ms)" "iter (ms)" "iter/bits"
+
+for x in $(seq "$N_INICIAL" "$N_FINAL"); do
+    for motor in bits iter; do
+        ARQUIVO_SAIDA="${motor}n${x}.txt"
+        > "$ARQUIVO_SAIDA"
+
+        for i in $(seq 1 $REPETICOES); do
+            "$PROGRAMA" "${x}" -m "$motor" >> "$ARQUIVO_SAIDA"
+        done
+    done
+
+    # Média das linhas "Tempo decorrido = X ms" de cada motor
+    MEDIA_BITS=$(awk '/^Tempo/ { s += $4; n++ } END { printf "%.3f", s / n }' "bitsn${x}.txt")
+    MEDIA_ITER=$(awk '/^Tempo/ { s += $4; n++ } END { printf "%.3f", s / n }' "itern${x}.txt")
+    RAZAO=$(awk -v a="$MEDIA_ITER" -v b="$MEDIA_BITS" 'BEGIN { printf "%.3f", a / b }')
+
+    printf "%4d %16s %16s %10s\n" "$x" "$MEDIA_BITS" "$MEDIA_ITER" "$RAZAO"
+done
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Lê o arquivo binário de soluções gerado pelo NDBS/NDBP (opção -o)
+// Uso: ./leitura solucoes.bin [quantidade a exibir]
+// Confere cada solução e exibe as primeiras no mesmo formato do printSolution
+
+#define MAX_TAM 64
+#define TAM_BLOCO 65536 // Soluções decodificadas por leitura
+
+// Cabeçalho do arquivo binário de soluções
+typedef struct {
+    char magica[4];        // "NDSO"
+    uint32_t tamanho;      // N do tabuleiro
+    uint32_t bitsPorLinha; // Bits usados por índice de linha
+} CabecalhoSolucoes;
+
+// Desempacota os índices de linha de uma solução
+void desempacotar(const unsigned char *origem, int n, int bitsPorLinha, int *board) {
+    uint64_t acumulador = 0;
+    int nBits = 0;
+    uint64_t mascara = (1ULL << bitsPorLinha) - 1;
+
+    for (int col = 0; col < n; col++) {
+        while (nBits < bitsPorLinha) {
+            acumulador |= (uint64_t)(*origem++) << nBits;
+            nBits += 8;
+        }
+        board[col] = acumulador & mascara;
+        acumulador >>= bitsPorLinha;
+        nBits -= bitsPorLinha;
+    }
+}
+
+// Confere se a solução é válida (sem linhas ou diagonais repetidas)
+int solucaoValida(const int *board, int n) {
+    for (int i = 0; i < n; i++) {
+        if (board[i] >= n) {
+            return 0;
+        }
+        for (int j = i + 1; j < n; j++) {
+            if (board[i] == board[j] || abs(board[i] - board[j]) == j - i) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    CabecalhoSolucoes cab;
+    unsigned char *bloco;
+    int board[MAX_TAM];
+    long long lidas = 0, invalidas = 0, exibir = 0;
+    size_t bytesPorSolucao, n;
+    FILE *fp_input;
+
+    if (argc <= 1) {
+        fprintf(stdout, "Uso: %s solucoes.bin [quantidade a exibir]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        exibir = strtoll(argv[2], NULL, 10);
+    }
+
+    fp_input = (strcmp(argv[1], "-") == 0) ? stdin : fopen(argv[1], "rb");
+    if (fp_input == NULL) {
+        perror("Erro ao abrir o arquivo de soluções");
+        return 1;
+    }
+
+    // Confere o cabeçalho
+    if (fread(&cab, sizeof(cab), 1, fp_input) != 1 || memcmp(cab.magica, "NDSO", 4) != 0 ||
+        cab.tamanho < 1 || cab.tamanho > MAX_TAM || cab.bitsPorLinha < 1 || cab.bitsPorLinha > 8) {
+        fprintf(stdout, "Arquivo de soluções inválido: %s\n", argv[1]);
+        return 1;
+    }
+    bytesPorSolucao = (cab.tamanho * cab.bitsPorLinha + 7) / 8;
+    bloco = (unsigned char *)malloc(TAM_BLOCO * bytesPorSolucao);
+
+    // Lê as soluções em blocos
+    while ((n = fread(bloco, bytesPorSolucao, TAM_BLOCO, fp_input)) > 0) {
+        for (size_t s = 0; s < n; s++) {
+            desempacotar(bloco + s * bytesPorSolucao, cab.tamanho, cab.bitsPorLinha, board);
+            lidas++;
+
+            if (!solucaoValida(board, cab.tamanho)) {
+                invalidas++;
+            }
+
+            // Exibe as coordenadas (linha, coluna) das primeiras soluções
+            if (lidas <= exibir) {
+                printf("Solução %lld: ", lidas);
+                for (uint32_t col = 0; col < cab.tamanho; col++) {
+                    printf("(%d, %d) ", board[col], col);
+                }
+                printf("\n");
+            }
+        }
+    }
+
+    if (fp_input != stdin) {
+        fclose(fp_input);
+    }
+    free(bloco);
+
+    printf("Soluções lidas para N=%u: %lld (inválidas: %lld)\n", cab.tamanho, lidas, invalidas);
+
+    return 0;
+}
@@ -18,8 +18,8 @@ echo "${REPETICOES} execuções para = ${n} POP = ${p} THREADS = ${t}"
 # Loop interno: Executa o comando várias vezes
 for i in $(seq 1 $REPETICOES); do
     # O comando é executado e a saída (stdout) é adicionada ao arquivo.
-    # ./ndgs >> "$ARQUIVO_SAIDA" # sequencial
-    ./ndgp >> "$ARQUIVO_SAIDA" # paralelo
+    # ./ndgs ${n} -p ${p} >> "$ARQUIVO_SAIDA" # sequencial
+    ./ndgp ${n} -p ${p} -t ${t} >> "$ARQUIVO_SAIDA" # paralelo
 done
 
 echo "Concluído para x=${n}. Total de ${REPETICOES} execuções registradas."
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+# Confere que a busca por mínimos conflitos sempre termina em tabuleiros pequenos
+# Roda cada N com várias sementes e um limite de tempo; uma execução que estoura o limite
+# indica laço sem fim no reparo (mínimo local sem reinício)
+# Uso: ./VarreduraMinConflitos.sh [programa] [sementes] [N inicial] [N final] [limite em s]
+# Exemplo: ./VarreduraMinConflitos.sh ./ndmc 30 4 40 5
+PROGRAMA=${1:-./ndmc}
+SEMENTES=${2:-30}
+N_INICIAL=${3:-4}
+N_FINAL=${4:-40}
+LIMITE=${5:-5}
+
+TRAVADAS=0
+SEM_SOLUCAO=0
+
+for x in $(seq "$N_INICIAL" "$N_FINAL"); do
+    for semente in $(seq 1 $SEMENTES); do
+        SAIDA=$(timeout "$LIMITE" "$PROGRAMA" "${x}" --seed "$semente")
+        if [ $? -eq 124 ]; then
+            echo "N=${x} semente=${semente}: não terminou em ${LIMITE} s"
+            TRAVADAS=$((TRAVADAS + 1))
+        elif ! echo "$SAIDA" | grep -q "^Solucao"; then
+            SEM_SOLUCAO=$((SEM_SOLUCAO + 1))
+        fi
+    done
+done
+
+echo "Execuções: $(( (N_FINAL - N_INICIAL + 1) * SEMENTES )), sem término: ${TRAVADAS}, sem solução: ${SEM_SOLUCAO}"
+[ "$TRAVADAS" -eq 0 ]
@@ -4,54 +4,201 @@
 // Trechos revisados para melhorar funcionamento e consistência
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
 #include <sys/time.h>
 #include <omp.h> // Biblioteca do openmp
 
 // Parâmetros de execução dos experimentos
-#define N_QUEENS 30 // Tamanho do tabuleiro
-#define POP_SIZE 2000 // Tamanho da população
-#define MAX_GENERATIONS 10000 // Número máximo de gerações
-#define MUTATION_RATE 0.10 // Taxa de mutação
-#define TOURNAMENT_SIZE 10 // Tamanho do torneio de aptidão
-#define STAGNATION_LIMIT 1000 // Limite de parada após gerações sem evolução
-#define N_THREADS 4 // Número de threads operando durante a execução
+#define N_QUEENS 30 // Tamanho padrão do tabuleiro (alterado pelo primeiro argumento)
+#define POP_SIZE 2000 // Tamanho padrão da população (-p)
+#define MAX_GENERATIONS 10000 // Número máximo padrão de gerações (-g)
+#define MUTATION_RATE 0.10 // Taxa de mutação padrão (-m)
+#define TOURNAMENT_SIZE 10 // Tamanho padrão do torneio de aptidão (-k)
+#define STAGNATION_LIMIT 1000 // Limite padrão de parada após gerações sem evolução (-e)
+#define CACHE_LINE 64 // Alinhamento das linhas de genes e contagens de cada indivíduo
+#define N_THREADS 4 // Número padrão de threads (alterado por -t ou por OMP_NUM_THREADS)
+#define MIGRANTS 2 // Migrantes padrão por envio no modelo de ilhas (-n)
 
-// Estrutura do indivíduo
-typedef struct {
-    int position[N_QUEENS]; // Posição final do indivíduo em uma coluna
-    int fitness; // Aptidão associada ao número de conflitos
-} Individual;
+// Chave da redução do melhor indivíduo: aptidão nos 32 bits altos e índice nos baixos
+// O mínimo das chaves escolhe a menor aptidão (e o menor índice) sem seção crítica
+#define BEST_KEY(fitness, index) (((long long)(fitness) << 32) | (long long)(index))
 
-// Função para gerar um valor inteiro aleatório seguro para threads
-int get_random_int_r(int max, unsigned int *seed) {
-    return (int)(rand_r(seed) % max);
+// Tamanho do tabuleiro da execução e função de aptidão escolhida para ele
+static int n_queens = N_QUEENS;
+static int n_threads = N_THREADS; // Threads operando durante a execução
+static int (*calculate_fitness)(const unsigned char *genome);
+
+// Parâmetros do algoritmo definidos na linha de comando
+static int pop_size = POP_SIZE;
+static int max_generations = MAX_GENERATIONS;
+static double mutation_rate = MUTATION_RATE;
+static int tournament_size = TOURNAMENT_SIZE;
+static int stagnation_limit = STAGNATION_LIMIT;
+static int local_search_steps = 0; // Passos de busca local por filho (-l; 0 = algoritmo genético puro)
+static uint64_t base_seed; // Semente da execução (--seed ou relógio)
+
+// Operadores de cruzamento (-x), todos lineares no tamanho do tabuleiro
+#define CROSSOVER_CUT 0 // Corte em um ponto completado na ordem do outro pai (padrão)
+#define CROSSOVER_OX 1  // Order crossover: trecho entre dois cortes, restante na ordem do outro pai
+#define CROSSOVER_PMX 2 // Partially mapped crossover: trecho entre dois cortes com mapeamento dos repetidos
+#define CROSSOVER_CX 3  // Cycle crossover: ciclos de posições herdados alternadamente
+static const char *crossover_names[] = {"corte", "ox", "pmx", "cx"};
+static int crossover_operator = CROSSOVER_CUT;
+
+// Genes compactos: 1 byte por coluna para N <= 256, senão 2 bytes (N limitado a UINT16_MAX em todos os modos)
+// Cada linha da matriz de genes ocupa gene_stride bytes (arredondado para a linha de cache)
+static int gene_bytes;
+static int gene_stride;
+
+// Contagens de diagonais por indivíduo: a troca da mutação atualiza a aptidão em O(1)
+// Com -f a aptidão é recalculada por inteiro a cada mutação (caminho de verificação)
+static int incremental_fitness = 1;
+static int count_stride; // Contadores reservados por indivíduo (4N-2 arredondado para a linha de cache)
+
+// População em estrutura de vetores
+// As aptidões ficam em um vetor contíguo separado dos genes: elitismo e torneio leem apenas esse vetor
+// Os genes formam uma matriz alinhada com uma linha por indivíduo (linha da dama em cada coluna)
+typedef struct{
+    int *fitness; // Aptidão associada ao número de conflitos
+    unsigned char *genes; // Matriz de genes (gene_stride bytes por indivíduo)
+    uint16_t *diag_counts; // Damas por diagonal: 2N-1 principais e 2N-1 secundárias (NULL com -f)
+} Population;
+
+// Área de trabalho do cruzamento (uma por thread, sem compartilhamento entre as threads)
+typedef struct{
+    int *position; // Posição de cada gene no pai de referência (PMX e CX)
+    uint64_t *marks; // Conjunto de bits dos genes (ou posições) já usados no filho
+} CrossoverWork;
+static CrossoverWork *crossover_work;
+
+// Contadores de diagonais da aptidão genérica (um bloco por thread, alinhado à linha de cache)
+// Ficam no heap: como vetores na pilha, N grande estouraria a pilha das threads
+static int *fitness_counts;
+static int fitness_stride;
+
+// Modelo de ilhas (-i): cada thread evolui a própria subpopulação e troca migrantes a cada intervalo
+#define TOPOLOGY_RING 0   // Cada ilha envia para a seguinte
+#define TOPOLOGY_RANDOM 1 // Cada ilha envia para outra ilha sorteada a cada migração
+static const char *topology_names[] = {"anel", "aleatoria"};
+static int topology = TOPOLOGY_RING;
+static int migration_interval = 0; // Gerações entre migrações (0 = população global única)
+static int n_migrants = MIGRANTS;
+
+// Caixa de mensagens de um par (destino, origem) de ilhas: um único remetente e um único destinatário
+// O remetente só escreve com a caixa vazia e o destinatário só lê com a caixa cheia;
+// a flag, lida e escrita atomicamente, é a única sincronização entre as duas threads
+typedef struct{
+    int full; // 1 quando há migrantes à espera do destinatário
+    Population *migrants; // Migrantes com genes, contagens e aptidões
+} __attribute__((aligned(CACHE_LINE))) Mailbox;
+
+// Migrações do modelo de ilhas (exibidas com -d)
+static long long migrations_sent, migrations_dropped, migrations_received;
+
+// Tempo acumulado por fase e por thread (exibido com -d)
+static double *phase_control, *phase_offspring, *phase_wait;
+
+// Marcas de presença dos genes em um conjunto de bits (64 genes por palavra)
+#define MARK_WORDS(n) (((n) + 63) / 64)
+#define IS_MARKED(marks, v) (((marks)[(v) >> 6] >> ((v) & 63)) & 1)
+#define SET_MARK(marks, v) ((marks)[(v) >> 6] |= 1ULL << ((v) & 63))
+
+// Gerador pseudoaleatório baseado em contador (SplitMix64)
+// Cada fluxo é derivado de (semente, geração, índice): o sorteio de um par de filhos
+// não depende da thread que o executa, e a mesma semente reproduz a execução
+typedef struct{
+    uint64_t counter; // Contador do fluxo, avançado a cada sorteio
+} RandomStream;
+
+// Função de mistura do SplitMix64 (bijeção de 64 bits)
+uint64_t mix64(uint64_t z){
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Função que cria o fluxo de um item de trabalho (geração 0 = população inicial)
+RandomStream random_stream(uint64_t seed, uint32_t generation, uint32_t index){
+    RandomStream rng;
+    rng.counter = mix64(seed ^ mix64(((uint64_t)generation << 32) | index));
+    return rng;
+}
+
+// Função que gera o próximo valor de 64 bits do fluxo
+uint64_t random_next(RandomStream *rng){
+    return mix64(rng->counter += 0x9E3779B97F4A7C15ULL);
+}
+
+// Função para gerar valores inteiros aleatórios em [0, max) sem viés
+// Multiplicação de Lemire: rejeita apenas a fração residual de 2^32 que não divide max
+int get_random_int(RandomStream *rng, int max){
+    uint64_t m = (random_next(rng) >> 32) * (uint64_t)max;
+
+    if((uint32_t)m < (uint32_t)max){
+        uint32_t threshold = -(uint32_t)max % (uint32_t)max;
+        while((uint32_t)m < threshold){
+            m = (random_next(rng) >> 32) * (uint64_t)max;
+        }
+    }
+    return (int)(m >> 32);
+}
+
+// Função para gerar um valor de ponto flutuante aleatório em [0, 1)
+double get_random_double(RandomStream *rng){
+    return (random_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Função que devolve a linha de genes de um indivíduo
+unsigned char *genome_of(const Population *population, int i){
+    return population->genes + (size_t)i * gene_stride;
+}
+
+// Função que devolve as contagens de diagonais de um indivíduo
+uint16_t *counts_of(const Population *population, int i){
+    return population->diag_counts + (size_t)i * count_stride;
 }
 
-// Função para gerar um valor de ponto flutuante aleatório seguro para threads
-double get_random_double_r(unsigned int *seed) {
-    return (double)rand_r(seed) / (double)RAND_MAX;
+// Função que lê a linha da dama em uma coluna do genoma
+int get_gene(const unsigned char *genome, int col){
+    return (gene_bytes == 1) ? genome[col] : ((const uint16_t *)genome)[col];
 }
 
-// Função que troca a posição de dois indivíduos
-void swap(int *a, int *b) {
-    int temp = *a; 
-    *a = *b; 
-    *b = temp;
+// Função que grava a linha da dama em uma coluna do genoma
+void set_gene(unsigned char *genome, int col, int row){
+    if(gene_bytes == 1){
+        genome[col] = row;
+    }
+    else{
+        ((uint16_t *)genome)[col] = row;
+    }
+}
+
+// Função que troca os genes de duas colunas
+void swap_genes(unsigned char *genome, int col1, int col2){
+    int temp = get_gene(genome, col1);
+    set_gene(genome, col1, get_gene(genome, col2));
+    set_gene(genome, col2, temp);
 }
 
 // Função que calcula a aptidão de cada indivíduo
-// Valores locais seguros para threads
-int calculate_fitness(int *positions){
-    int d1_counts[2 * N_QUEENS - 1] = {0};
-    int d2_counts[2 * N_QUEENS - 1] = {0};
+// Contadores na área da própria thread
+// Versão genérica para qualquer tamanho
+int calculate_fitness_generic(const unsigned char *genome){
+    int *d1_counts = fitness_counts + omp_get_thread_num() * fitness_stride;
+    int *d2_counts = d1_counts + 2 * n_queens - 1;
 
-    for(int i = 0; i < N_QUEENS; i++){
-        d1_counts[i - positions[i] + (N_QUEENS - 1)]++;
-        d2_counts[i + positions[i]]++;                  
+    memset(d1_counts, 0, (4 * n_queens - 2) * sizeof(int));
+
+    for(int i = 0; i < n_queens; i++){
+        int row = get_gene(genome, i);
+        d1_counts[i - row + (n_queens - 1)]++;
+        d2_counts[i + row]++;
     }
 
     int conflicts = 0;
-    for(int i = 0; i < 2 * N_QUEENS - 1; i++){
+    for(int i = 0; i < 2 * n_queens - 1; i++){
         if(d1_counts[i] > 1){
             conflicts += d1_counts[i] - 1;
         }
@@ -62,252 +209,920 @@ int calculate_fitness(int *positions){
     return conflicts;
 }
 
+// Gera a função de aptidão especializada para um tamanho fixo em tempo de compilação
+// Com N constante os laços têm limites conhecidos e os contadores ficam do tamanho exato
+// Todos os tamanhos especializados cabem em genes de 1 byte
+#define DEFINE_FITNESS(N) \
+int calculate_fitness_##N(const unsigned char *genome){ \
+    int d1_counts[2 * N - 1] = {0}; \
+    int d2_counts[2 * N - 1] = {0}; \
+    for(int i = 0; i < N; i++){ \
+        d1_counts[i - genome[i] + (N - 1)]++; \
+        d2_counts[i + genome[i]]++; \
+    } \
+    int conflicts = 0; \
+    for(int i = 0; i < 2 * N - 1; i++){ \
+        conflicts += (d1_counts[i] > 1 ? d1_counts[i] - 1 : 0) + (d2_counts[i] > 1 ? d2_counts[i] - 1 : 0); \
+    } \
+    return conflicts; \
+}
+
+// Tamanhos comuns nos experimentos com aptidão especializada
+#define FITNESS_SIZES(X) X(8) X(16) X(30) X(32) X(50) X(64) X(100) X(128)
+
+FITNESS_SIZES(DEFINE_FITNESS)
+
+// Função que escolhe a aptidão especializada do tamanho pedido (ou a genérica)
+void select_fitness(){
+    calculate_fitness = calculate_fitness_generic;
+
+    #define SELECT_FITNESS(N) if(n_queens == N){ calculate_fitness = calculate_fitness_##N; }
+    FITNESS_SIZES(SELECT_FITNESS)
+    #undef SELECT_FITNESS
+}
+
+// Função que aloca uma população: vetor de aptidões e matrizes alinhadas de genes e contagens
+Population *allocate_population(int size){
+    Population *population = (Population *)malloc(sizeof(Population));
+
+    if(population == NULL ||
+       posix_memalign((void **)&population->fitness, CACHE_LINE, size * sizeof(int)) != 0 ||
+       posix_memalign((void **)&population->genes, CACHE_LINE, (size_t)size * gene_stride) != 0){
+        fprintf(stdout, "Memória insuficiente para a população (%d indivíduos, N=%d)\n", size, n_queens);
+        exit(1);
+    }
+    population->diag_counts = NULL;
+    if(incremental_fitness &&
+       posix_memalign((void **)&population->diag_counts, CACHE_LINE, (size_t)size * count_stride * sizeof(uint16_t)) != 0){
+        fprintf(stdout, "Memória insuficiente para a população (%d indivíduos, N=%d)\n", size, n_queens);
+        exit(1);
+    }
+    return population;
+}
+
+// Função que libera a população
+void free_population(Population *population){
+    free(population->fitness);
+    free(population->genes);
+    free(population->diag_counts);
+    free(population);
+}
+
+// Função que aloca as áreas de trabalho do cruzamento, alinhadas à linha de cache
+CrossoverWork *allocate_crossover_work(int count){
+    CrossoverWork *work = (CrossoverWork *)malloc(count * sizeof(CrossoverWork));
+
+    for(int t = 0; t < count; t++){
+        if(work == NULL ||
+           posix_memalign((void **)&work[t].position, CACHE_LINE, n_queens * sizeof(int)) != 0 ||
+           posix_memalign((void **)&work[t].marks, CACHE_LINE, MARK_WORDS(n_queens) * sizeof(uint64_t)) != 0){
+            fprintf(stdout, "Memória insuficiente para o cruzamento (N=%d)\n", n_queens);
+            exit(1);
+        }
+    }
+    return work;
+}
+
+// Função que libera as áreas de trabalho do cruzamento
+void free_crossover_work(CrossoverWork *work, int count){
+    for(int t = 0; t < count; t++){
+        free(work[t].position);
+        free(work[t].marks);
+    }
+    free(work);
+}
+
+// Função que aloca os contadores da aptidão genérica, um bloco alinhado por thread
+int *allocate_fitness_counts(int count){
+    int *counts = NULL;
+
+    fitness_stride = (int)(((4 * n_queens - 2) * sizeof(int) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE / sizeof(int));
+    if(posix_memalign((void **)&counts, CACHE_LINE, (size_t)count * fitness_stride * sizeof(int)) != 0){
+        fprintf(stdout, "Memória insuficiente para a aptidão (N=%d)\n", n_queens);
+        exit(1);
+    }
+    return counts;
+}
+
+// Função que copia os genes, as contagens de diagonais e a aptidão de um indivíduo
+void copy_individual(Population *dest, int di, const Population *src, int si){
+    memcpy(genome_of(dest, di), genome_of(src, si), n_queens * gene_bytes);
+    if(dest->diag_counts != NULL){
+        memcpy(counts_of(dest, di), counts_of(src, si), (4 * n_queens - 2) * sizeof(uint16_t));
+    }
+    dest->fitness[di] = src->fitness[si];
+}
+
+// Função que avalia um indivíduo recém-gerado
+// Com as contagens ativas, monta os contadores de diagonais junto com a aptidão
+void evaluate_individual(Population *population, int i){
+    const unsigned char *genome = genome_of(population, i);
+
+    if(population->diag_counts == NULL){
+        population->fitness[i] = calculate_fitness(genome);
+        return;
+    }
+
+    uint16_t *d1_counts = counts_of(population, i);
+    uint16_t *d2_counts = d1_counts + 2 * n_queens - 1;
+    int conflicts = 0;
+
+    memset(d1_counts, 0, (4 * n_queens - 2) * sizeof(uint16_t));
+    for(int col = 0; col < n_queens; col++){
+        int row = get_gene(genome, col);
+
+        // Cada dama a mais em uma diagonal já ocupada é um conflito
+        conflicts += (d1_counts[col - row + (n_queens - 1)]++ > 0);
+        conflicts += (d2_counts[col + row]++ > 0);
+    }
+    population->fitness[i] = conflicts;
+}
+
+// Função que troca as damas de duas colunas e atualiza a aptidão pelas quatro diagonais afetadas
+void swap_queens(Population *population, int i, int col1, int col2){
+    unsigned char *genome = genome_of(population, i);
+    uint16_t *d1_counts = counts_of(population, i);
+    uint16_t *d2_counts = d1_counts + 2 * n_queens - 1;
+    int row1 = get_gene(genome, col1);
+    int row2 = get_gene(genome, col2);
+    int conflicts = population->fitness[i];
+
+    // Retira as duas damas das diagonais atuais
+    conflicts -= (--d1_counts[col1 - row1 + (n_queens - 1)] > 0);
+    conflicts -= (--d2_counts[col1 + row1] > 0);
+    conflicts -= (--d1_counts[col2 - row2 + (n_queens - 1)] > 0);
+    conflicts -= (--d2_counts[col2 + row2] > 0);
+
+    // Recoloca as damas com as linhas trocadas
+    conflicts += (d1_counts[col1 - row2 + (n_queens - 1)]++ > 0);
+    conflicts += (d2_counts[col1 + row2]++ > 0);
+    conflicts += (d1_counts[col2 - row1 + (n_queens - 1)]++ > 0);
+    conflicts += (d2_counts[col2 + row1]++ > 0);
+
+    set_gene(genome, col1, row2);
+    set_gene(genome, col2, row1);
+    population->fitness[i] = conflicts;
+}
+
 // Função que define a configuração inicial do tabuleiro
 // Distribui as atribuições e as trocas entre as threads
-void initialize_population_parallel(Individual population[], unsigned int base_seed){
-    #pragma omp parallel num_threads(N_THREADS)
+void initialize_population_parallel(Population *population){
+    #pragma omp parallel num_threads(n_threads)
     {
-        // Define uma semente para cada thread
-        int thread_id = omp_get_thread_num();
-        unsigned int seed = base_seed + thread_id;
-
         #pragma omp for schedule(static)
-        for(int i = 0; i < POP_SIZE; i++){
+        for(int i = 0; i < pop_size; i++){
+            unsigned char *genome = genome_of(population, i);
+
+            // Fluxo aleatório próprio do indivíduo
+            RandomStream rng = random_stream(base_seed, 0, i);
+
             // Atribuição inicial na diagonal principal
-            for(int j = 0; j < N_QUEENS; j++){
-                population[i].position[j] = j;
+            for(int j = 0; j < n_queens; j++){
+                set_gene(genome, j, j);
             }
 
             // Embaralha as posições com o algoritmo de Fisher-Yates
-            for(int j = N_QUEENS - 1; j > 0; j--){
-                // Posição de troca aleatória segura para threads
-                int k = get_random_int_r(j + 1, &seed);
-                swap(&population[i].position[j], &population[i].position[k]);
+            for(int j = n_queens - 1; j > 0; j--){
+                // Posição de troca aleatória
+                int k = get_random_int(&rng, j + 1);
+                swap_genes(genome, j, k);
             }
             // Avalia a aptidão da primeira geração
-            population[i].fitness = calculate_fitness(population[i].position);
+            evaluate_individual(population, i);
         }
     }
 }
 
 // Função que realiza o torneio de aptidão
+// Devolve o índice do vencedor consultando apenas o vetor de aptidões
 // Chamada dentro de trecho paralelo seguro
-Individual tournament_selection_parallel(const Individual population[], unsigned int *seed){
-    Individual best = population[get_random_int_r(POP_SIZE, seed)];
+int tournament_selection_parallel(const Population *population, int size, RandomStream *rng){
+    int best = get_random_int(rng, size);
 
     // Escolhe o melhor indivíduo
-    for(int i = 1; i < TOURNAMENT_SIZE; i++){
-        Individual current = population[get_random_int_r(POP_SIZE, seed)];
-        if(current.fitness < best.fitness){
+    for(int i = 1; i < tournament_size; i++){
+        int current = get_random_int(rng, size);
+        if(population->fitness[current] < population->fitness[best]){
             best = current;
         }
     }
     return best;
 }
 
+// Gera os operadores de cruzamento para um tipo de gene (1 ou 2 bytes), todos em O(N)
+// order_child: herda o trecho [a, b) de pa e completa a partir da posição b (com volta)
+//   com os genes de pb ausentes do trecho, lidos a partir de start (corte: a = 0 e start = 0; OX: start = b)
+// pmx_child: herda o trecho [a, b) de pa; fora dele usa pb, seguindo o mapeamento do trecho nos repetidos
+// cycle_children: copia os ciclos de posições dos pais alternando o pai de origem (CX)
+#define DEFINE_CROSSOVER(TYPE, BITS) \
+void order_child_##BITS(const TYPE *pa, const TYPE *pb, TYPE *c, int a, int b, int start, uint64_t *marks){ \
+    memset(marks, 0, MARK_WORDS(n_queens) * sizeof(uint64_t)); \
+    for(int i = a; i < b; i++){ \
+        c[i] = pa[i]; \
+        SET_MARK(marks, pa[i]); \
+    } \
+    int k = (b == n_queens) ? 0 : b; \
+    int j = (start == n_queens) ? 0 : start; \
+    for(int n = 0; n < n_queens; n++){ \
+        TYPE val = pb[j]; \
+        if(++j == n_queens){ \
+            j = 0; \
+        } \
+        if(!IS_MARKED(marks, val)){ \
+            c[k] = val; \
+            if(++k == n_queens){ \
+                k = 0; \
+            } \
+        } \
+    } \
+} \
+\
+void pmx_child_##BITS(const TYPE *pa, const TYPE *pb, TYPE *c, int a, int b, int *position, uint64_t *marks){ \
+    memset(marks, 0, MARK_WORDS(n_queens) * sizeof(uint64_t)); \
+    for(int i = a; i < b; i++){ \
+        c[i] = pa[i]; \
+        SET_MARK(marks, pa[i]); \
+        position[pa[i]] = i; \
+    } \
+    for(int i = 0; i < n_queens; i++){ \
+        if(i >= a && i < b){ \
+            continue; \
+        } \
+        TYPE val = pb[i]; \
+        while(IS_MARKED(marks, val)){ \
+            val = pb[position[val]]; \
+        } \
+        c[i] = val; \
+    } \
+} \
+\
+void cycle_children_##BITS(const TYPE *p1, const TYPE *p2, TYPE *c1, TYPE *c2, int *position, uint64_t *marks){ \
+    memset(marks, 0, MARK_WORDS(n_queens) * sizeof(uint64_t)); \
+    for(int i = 0; i < n_queens; i++){ \
+        position[p1[i]] = i; \
+    } \
+    int from_first = 1; \
+    for(int start = 0; start < n_queens; start++){ \
+        if(IS_MARKED(marks, start)){ \
+            continue; \
+        } \
+        int i = start; \
+        do{ \
+            SET_MARK(marks, i); \
+            c1[i] = from_first ? p1[i] : p2[i]; \
+            c2[i] = from_first ? p2[i] : p1[i]; \
+            i = position[p2[i]]; \
+        }while(i != start); \
+        from_first = !from_first; \
+    } \
+} \
+\
+void crossover_genes_##BITS(const TYPE *p1, const TYPE *p2, TYPE *c1, TYPE *c2, CrossoverWork *work, RandomStream *rng){ \
+    if(crossover_operator == CROSSOVER_CX){ \
+        cycle_children_##BITS(p1, p2, c1, c2, work->position, work->marks); \
+        return; \
+    } \
+    int a = 0, b; \
+    if(crossover_operator == CROSSOVER_CUT){ \
+        b = get_random_int(rng, n_queens); \
+    } \
+    else{ \
+        a = get_random_int(rng, n_queens); \
+        b = get_random_int(rng, n_queens); \
+        if(a > b){ \
+            int tmp = a; \
+            a = b; \
+            b = tmp; \
+        } \
+        b++; \
+    } \
+    if(crossover_operator == CROSSOVER_PMX){ \
+        pmx_child_##BITS(p1, p2, c1, a, b, work->position, work->marks); \
+        pmx_child_##BITS(p2, p1, c2, a, b, work->position, work->marks); \
+    } \
+    else{ \
+        int start = (crossover_operator == CROSSOVER_OX) ? b : 0; \
+        order_child_##BITS(p1, p2, c1, a, b, start, work->marks); \
+        order_child_##BITS(p2, p1, c2, a, b, start, work->marks); \
+    } \
+}
+
+DEFINE_CROSSOVER(uint8_t, 8)
+DEFINE_CROSSOVER(uint16_t, 16)
+
 // Função para cruzar indivíduos, gerando dois novos indivíduos
 // Chamada dentro de trecho paralelo seguro
-void crossover_parallel(const Individual *parent1, const Individual *parent2, 
-                        Individual *child1, Individual *child2, unsigned int *seed){
-    int cut = get_random_int_r(N_QUEENS, seed);
-    int k1 = cut, k2 = cut;
+void crossover_parallel(const Population *population, int parent1, int parent2,
+                        Population *next, int child1, int child2, RandomStream *rng){
+    CrossoverWork *work = &crossover_work[omp_get_thread_num()];
 
-    for(int i = 0; i < cut; i++){
-        child1->position[i] = parent1->position[i];
-        child2->position[i] = parent2->position[i];
+    if(gene_bytes == 1){
+        crossover_genes_8(genome_of(population, parent1), genome_of(population, parent2),
+                          genome_of(next, child1), genome_of(next, child2), work, rng);
     }
-
-    for(int i = 0; i < N_QUEENS; i++) {
-        int val = parent2->position[i], present = 0;
-        for(int j = 0; j < cut; j++){
-            if(child1->position[j] == val){
-                 present = 1; break;
-            }
-        } 
-
-        if(!present){
-            child1->position[k1++] = val;
-        }
+    else{
+        crossover_genes_16((const uint16_t *)genome_of(population, parent1), (const uint16_t *)genome_of(population, parent2),
+                           (uint16_t *)genome_of(next, child1), (uint16_t *)genome_of(next, child2), work, rng);
     }
-    for(int i = 0; i < N_QUEENS; i++){
-        int val = parent1->position[i], present = 0;
+}
+
+// Função que aplica mutação em um indivíduo
+// O indivíduo chega avaliado; a troca usa as contagens de diagonais quando ativas
+// Chamada dentro de trecho paralelo seguro
+void mutate_parallel(Population *population, int i, RandomStream *rng){
+    if(get_random_double(rng) < mutation_rate){
+        int index1 = get_random_int(rng, n_queens);
+        int index2 = get_random_int(rng, n_queens);
         
-        for(int j = 0; j < cut; j++){
-            if(child2->position[j] == val){
-                 present = 1; break; 
+        // Faz uma troca aleatória das posições e avalia a nova aptidão do indivíduo
+        if(index1 != index2){
+            if(population->diag_counts != NULL){
+                swap_queens(population, i, index1, index2);
+            }
+            else{
+                swap_genes(genome_of(population, i), index1, index2);
+                population->fitness[i] = calculate_fitness(genome_of(population, i));
             }
         }
 
-        if(!present){
-            child2->position[k2++] = val;
-        } 
+#ifdef VERIFICAR_APTIDAO
+        // Confere a atualização incremental com o cálculo completo
+        if(population->fitness[i] != calculate_fitness(genome_of(population, i))){
+            fprintf(stdout, "Aptidão incremental divergente: %d (esperada %d)\n",
+                    population->fitness[i], calculate_fitness(genome_of(population, i)));
+            exit(1);
+        }
+#endif
     }
 }
 
-// Função que aplica mutação em um indivíduo
+// Função que devolve a primeira dama em conflito a partir da coluna inicial (com volta)
+// Usa as contagens de diagonais do indivíduo; sem conflitos devolve a própria coluna inicial
+int find_conflicted(const Population *population, int i, int start){
+    const unsigned char *genome = genome_of(population, i);
+    const uint16_t *d1_counts = counts_of(population, i);
+    const uint16_t *d2_counts = d1_counts + 2 * n_queens - 1;
+    int col = start;
+
+    do{
+        int row = get_gene(genome, col);
+        if(d1_counts[col - row + (n_queens - 1)] > 1 || d2_counts[col + row] > 1){
+            return col;
+        }
+        if(++col == n_queens){
+            col = 0;
+        }
+    }while(col != start);
+    return start;
+}
+
+// Função que refina um filho por descida com trocas dirigidas aos conflitos (passo memético, -l)
+// Cada passo troca uma dama em conflito com uma coluna sorteada e desfaz a troca se a aptidão piorar;
+// trocas que mantêm a aptidão ficam, para atravessar platôs. Sem as contagens (-f) a dama é sorteada
+// e cada tentativa recalcula a aptidão por inteiro
 // Chamada dentro de trecho paralelo seguro
-void mutate_parallel(Individual *individual, unsigned int *seed){
-    if(get_random_double_r(seed) < MUTATION_RATE){
-        int index1 = get_random_int_r(N_QUEENS, seed);
-        int index2 = get_random_int_r(N_QUEENS, seed);
-        
-        // Faz uma troca aleatória das posições
-        if(index1 != index2){
-            swap(&individual->position[index1], &individual->position[index2]);
+void local_search_parallel(Population *population, int i, RandomStream *rng){
+    for(int step = 0; step < local_search_steps && population->fitness[i] > 0; step++){
+        int before = population->fitness[i];
+        int col1 = get_random_int(rng, n_queens);
+        int col2 = get_random_int(rng, n_queens);
+
+        if(population->diag_counts != NULL){
+            col1 = find_conflicted(population, i, col1);
         }
-        
-        // Avalia a nova aptidão do indivíduo
-        individual->fitness = calculate_fitness(individual->position);
+        if(col1 == col2){
+            continue;
+        }
+
+        if(population->diag_counts != NULL){
+            swap_queens(population, i, col1, col2);
+            if(population->fitness[i] > before){
+                swap_queens(population, i, col1, col2);
+            }
+        }
+        else{
+            swap_genes(genome_of(population, i), col1, col2);
+            population->fitness[i] = calculate_fitness(genome_of(population, i));
+            if(population->fitness[i] > before){
+                swap_genes(genome_of(population, i), col1, col2);
+                population->fitness[i] = before;
+            }
+        }
+    }
+
+#ifdef VERIFICAR_APTIDAO
+    // Confere a aptidão mantida pela busca local com o cálculo completo
+    if(population->fitness[i] != calculate_fitness(genome_of(population, i))){
+        fprintf(stdout, "Aptidão divergente após a busca local: %d (esperada %d)\n",
+                population->fitness[i], calculate_fitness(genome_of(population, i)));
+        exit(1);
     }
+#endif
 }
 
 // Função que imprime o tabuleiro para fins de validação
 // Fora do loop paralelo de interesse
-void print_solution(Individual solution){
-    printf("\nSolucao encontrada para N=%d)\n", N_QUEENS);
-    printf("Aptidão: %d\n", solution.fitness);
+void print_solution(const Population *population, int index){
+    const unsigned char *genome = genome_of(population, index);
 
-    if(N_QUEENS <= 50){    
+    printf("\nSolucao encontrada para N=%d)\n", n_queens);
+    printf("Aptidão: %d\n", population->fitness[index]);
+
+    if(n_queens <= 50){    
         // Impressão em formato de matriz (0 = vazio e 1 = dama)
-        for(int i = 0; i < N_QUEENS; i++){
-            for(int j = 0; j < N_QUEENS; j++){
-                printf("%d ", solution.position[i] == j ? 1 : 0);
+        for(int i = 0; i < n_queens; i++){
+            for(int j = 0; j < n_queens; j++){
+                printf("%d ", get_gene(genome, i) == j ? 1 : 0);
             }
             printf("\n");
         }
     }
     else{    
         // Impressão em formato de lista (posições)
-        for(int i = 0; i < N_QUEENS; i++){
-            printf("(%d, %d) ", i, solution.position[i]);
+        for(int i = 0; i < n_queens; i++){
+            printf("(%d, %d) ", i, get_gene(genome, i));
         }
         printf("\n");
     }
 }
 
-// Função que gerencia o processamento principal
-// Trecho paralelo de interesse
-int main(){
+// Evolui a população global: todas as threads produzem os descendentes de cada geração
+// e uma thread faz o controle entre as barreiras. Devolve a última geração
+int evolve_population(Population *population, Population *new_population, Population *best_solution){
     int generation = 0;
     int stagnation_counter = 0;
-    struct timeval tv, start, stop;
 
-    gettimeofday(&tv, NULL);
+    // Estado compartilhado do laço de gerações
+    long long best_key = LLONG_MAX; // Melhor chave da população atual (redução min)
+    int finished = 0;
 
-    // Semente aleatória com definição aprimorada
-    unsigned long base_seed = (unsigned long)tv.tv_sec * 1000000 + tv.tv_usec;
+    // Região paralela única para toda a execução
+    // Cada geração tem duas etapas separadas por barreiras: descendentes (todas as threads)
+    // e controle (uma thread: troca das populações, elitismo, estagnação e parada)
+    #pragma omp parallel num_threads(n_threads)
+    {
+        int tid = omp_get_thread_num();
 
-    Individual population[POP_SIZE];
-    Individual new_population[POP_SIZE];
-    Individual best_solution;
-    best_solution.fitness = N_QUEENS * N_QUEENS;
+        // Melhor indivíduo da população inicial
+        #pragma omp for schedule(static) reduction(min:best_key)
+        for(int i = 0; i < pop_size; i++){
+            if(BEST_KEY(population->fitness[i], i) < best_key){
+                best_key = BEST_KEY(population->fitness[i], i);
+            }
+        }
 
-    // Inicializa valores das primeiras populações
-    initialize_population_parallel(population, base_seed);
+        // Loop principal de simulação
+        for(int gen = 0; ; gen++){
+            double t0 = omp_get_wtime();
 
-    // Obtém o tempo inicial
-    gettimeofday(&start, NULL);
+            // Controle da geração (barreira implícita ao final do single)
+            #pragma omp single
+            {
+                // A nova população (já avaliada) passa a ser a atual pela troca dos ponteiros
+                if(gen > 0){
+                    Population *previous = population;
+                    population = new_population;
+                    new_population = previous;
+                }
+                generation = gen;
 
-    // Loop principal de simulação
-    for(generation = 0; generation < MAX_GENERATIONS; generation++){
-        // Aplicando elitismo
-        Individual current_best;
-        current_best.fitness = N_QUEENS * N_QUEENS;
+                if(gen == max_generations){
+                    finished = 1;
+                }
+                else{
+                    // Aplicando elitismo com o melhor indivíduo reduzido na etapa anterior
+                    int current_best = (int)(best_key & 0xffffffff);
 
-        // Primeiro trecho paralelo seguro
-        #pragma omp parallel num_threads(N_THREADS)
-        {
-            Individual local_best;
-            local_best.fitness = N_QUEENS * N_QUEENS;
-
-            // Distribui as comparações entre as threads
-            #pragma omp for nowait schedule(static)
-            for(int i = 0; i < POP_SIZE; i++){
-                if(population[i].fitness < local_best.fitness){
-                    local_best = population[i];
+                    // Verificação de estagnação
+                    if(population->fitness[current_best] < best_solution->fitness[0]){ 
+                        copy_individual(best_solution, 0, population, current_best);
+                        stagnation_counter = 0;
+                    }
+                    else{
+                        stagnation_counter++;
+                    }
+
+                    // Encerra se encontrar solução ou atingir estagnação
+                    if(best_solution->fitness[0] == 0 || stagnation_counter >= stagnation_limit){
+                        finished = 1;
+                    }
+                    else{
+                        // Segue a busca por solução: o elite ocupa a posição 0 e entra na próxima redução
+                        copy_individual(new_population, 0, best_solution, 0);
+                        best_key = BEST_KEY(best_solution->fitness[0], 0);
+                    }
                 }
             }
+            double t1 = omp_get_wtime();
+            phase_control[tid] += t1 - t0;
 
-            // Ponto crítico de sincronização
-            #pragma omp critical
-            {
-                if(local_best.fitness < current_best.fitness){
-                    current_best = local_best;
+            if(finished){
+                break;
+            }
+
+            // Processo de variabilidade genética com a redução do melhor filho
+            #pragma omp for schedule(static) reduction(min:best_key) nowait
+            for(int i = 1; i < pop_size; i += 2){
+                // Fluxo aleatório do par: o resultado não depende da thread que o executa
+                RandomStream rng = random_stream(base_seed, gen + 1, i);
+
+                // Escolhe dois "bons" indivíduos
+                int parent1 = tournament_selection_parallel(population, pop_size, &rng);
+                int parent2 = tournament_selection_parallel(population, pop_size, &rng);
+
+                // Cruzamento entre os dois indivíduos escolhidos, direto na nova população
+                crossover_parallel(population, parent1, parent2, new_population, i, i + 1, &rng);
+
+                // Avalia e aplica mutação no primeiro filho gerado pelo cruzamento
+                evaluate_individual(new_population, i);
+                mutate_parallel(new_population, i, &rng);
+                local_search_parallel(new_population, i, &rng);
+                if(BEST_KEY(new_population->fitness[i], i) < best_key){
+                    best_key = BEST_KEY(new_population->fitness[i], i);
+                }
+
+                // Avalia e aplica mutação no segundo filho gerado pelo cruzamento
+                if(i + 1 < pop_size){
+                    evaluate_individual(new_population, i + 1);
+                    mutate_parallel(new_population, i + 1, &rng);
+                    local_search_parallel(new_population, i + 1, &rng);
+                    if(BEST_KEY(new_population->fitness[i + 1], i + 1) < best_key){
+                        best_key = BEST_KEY(new_population->fitness[i + 1], i + 1);
+                    }
                 }
             }
-        }
+            double t2 = omp_get_wtime();
 
-        // Verificação de estagnação
-        if(current_best.fitness < best_solution.fitness){ 
-            best_solution = current_best; 
-            stagnation_counter = 0;
-        }
-        else{
-            stagnation_counter++;
+            // A redução fica completa na barreira
+            #pragma omp barrier
+            phase_offspring[tid] += t2 - t1;
+            phase_wait[tid] += omp_get_wtime() - t2;
         }
+    }
+
+    return generation;
+}
+
+// Evolui uma subpopulação por thread (modelo de ilhas), sem barreiras entre as gerações
+// A cada migration_interval gerações a ilha envia o elite e vencedores de torneios para outra ilha
+// e recebe os migrantes que chegaram, que substituem os piores indivíduos
+// A população inicial é a mesma do modo global; com --seed a chegada dos migrantes ainda depende do ritmo das threads
+// Devolve a geração em que a melhor ilha terminou
+int evolve_islands(const Population *population, Population *best_solution){
+    int generation = 0;
+    int solved = 0; // Alguma ilha encontrou solução (lido e escrito atomicamente)
+
+    // Caixas de mensagens: mailboxes[destino * n_threads + origem]
+    Mailbox *mailboxes;
+    if(posix_memalign((void **)&mailboxes, CACHE_LINE, (size_t)n_threads * n_threads * sizeof(Mailbox)) != 0){
+        fprintf(stdout, "Memória insuficiente para as caixas de migração\n");
+        exit(1);
+    }
+    for(int m = 0; m < n_threads * n_threads; m++){
+        mailboxes[m].full = 0;
+        mailboxes[m].migrants = allocate_population(n_migrants);
+    }
 
-        // Encerra se encontrar solução ou atingir estagnação
-        if(best_solution.fitness == 0 || stagnation_counter >= STAGNATION_LIMIT){
-            gettimeofday(&stop, NULL);
-            break;
+    #pragma omp parallel num_threads(n_threads)
+    {
+        int island = omp_get_thread_num();
+        int first = (int)((long long)island * pop_size / n_threads);
+        int size = (int)((long long)(island + 1) * pop_size / n_threads) - first;
+        int stagnation_counter = 0, current_best = 0, full, gen;
+        long long sent = 0, dropped = 0, received = 0;
+
+        // Subpopulações alocadas pela própria thread; a inicial é o trecho da população global
+        Population *current = allocate_population(size + 1);
+        Population *next = allocate_population(size + 1);
+        Population *best = allocate_population(1);
+        best->fitness[0] = n_queens * n_queens;
+        for(int i = 0; i < size; i++){
+            copy_individual(current, i, population, first + i);
+            if(current->fitness[i] < current->fitness[current_best]){
+                current_best = i;
+            }
         }
 
-        // Segue a busca por solução
-        new_population[0] = best_solution;
-        
-        // Segundo trecho paralelo seguro
-        #pragma omp parallel num_threads(N_THREADS)
-        {
-            int tid = omp_get_thread_num();
-            // Define uma semente para cada thread
-            unsigned int seed = base_seed + generation * POP_SIZE + tid;
+        for(gen = 0; ; gen++){
+            double t0 = omp_get_wtime();
 
-            // Processo de variabilidade genética
-            #pragma omp for schedule(static)
-            for(int i = 1; i < POP_SIZE; i += 2){
-                // Escolhe dois "bons" indivíduos
-                Individual parent1 = tournament_selection_parallel(population, &seed);
-                Individual parent2 = tournament_selection_parallel(population, &seed);
+            if(gen > 0){
+                Population *previous = current;
+                current = next;
+                next = previous;
+            }
 
-                Individual child1, child2;
+            // Encerra ao atingir o limite de gerações ou quando outra ilha encontrou solução
+            #pragma omp atomic read seq_cst
+            full = solved;
+            if(gen == max_generations || full){
+                break;
+            }
 
-                // Cruzamento entre os dois indivíduos escolhidos
-                crossover_parallel(&parent1, &parent2, &child1, &child2, &seed);
+            // Elitismo e estagnação da ilha
+            if(current->fitness[current_best] < best->fitness[0]){
+                copy_individual(best, 0, current, current_best);
+                stagnation_counter = 0;
+            }
+            else{
+                stagnation_counter++;
+            }
+            if(best->fitness[0] == 0){
+                #pragma omp atomic write seq_cst
+                solved = 1;
+                break;
+            }
+            if(stagnation_counter >= stagnation_limit){
+                break;
+            }
+            copy_individual(next, 0, best, 0);
+            current_best = 0;
+
+            // Migração: envia se a caixa do destino estiver vazia e recebe das caixas cheias
+            if(n_threads > 1 && gen > 0 && gen % migration_interval == 0){
+                RandomStream rng = random_stream(base_seed, gen + 1, pop_size + island);
+                int dest = (island + 1) % n_threads;
+
+                if(topology == TOPOLOGY_RANDOM){
+                    dest = get_random_int(&rng, n_threads - 1);
+                    dest += (dest >= island);
+                }
+
+                Mailbox *out = &mailboxes[dest * n_threads + island];
+                #pragma omp atomic read seq_cst
+                full = out->full;
+                if(!full){
+                    copy_individual(out->migrants, 0, best, 0);
+                    for(int m = 1; m < n_migrants; m++){
+                        copy_individual(out->migrants, m, current, tournament_selection_parallel(current, size, &rng));
+                    }
+                    #pragma omp atomic write seq_cst
+                    out->full = 1;
+                    sent++;
+                }
+                else{
+                    dropped++;
+                }
 
-                // Aplica mutação no primeiro filho gerado pelo cruzamento
-                mutate_parallel(&child1, &seed);
+                for(int src = 0; src < n_threads; src++){
+                    Mailbox *in = &mailboxes[island * n_threads + src];
+                    if(src == island){
+                        continue;
+                    }
+                    #pragma omp atomic read seq_cst
+                    full = in->full;
+                    if(!full){
+                        continue;
+                    }
+                    for(int m = 0; m < n_migrants; m++){
+                        int worst = 0;
+                        for(int i = 1; i < size; i++){
+                            if(current->fitness[i] > current->fitness[worst]){
+                                worst = i;
+                            }
+                        }
+                        if(in->migrants->fitness[m] < current->fitness[worst]){
+                            copy_individual(current, worst, in->migrants, m);
+                        }
 
-                new_population[i] = child1;
+                        // Um migrante melhor que o elite passa a ser o elite da ilha
+                        if(in->migrants->fitness[m] < best->fitness[0]){
+                            copy_individual(best, 0, in->migrants, m);
+                            copy_individual(next, 0, best, 0);
+                        }
+                    }
+                    #pragma omp atomic write seq_cst
+                    in->full = 0;
+                    received++;
+                }
+            }
+            double t1 = omp_get_wtime();
+
+            // Descendentes da ilha com os mesmos fluxos aleatórios do modo global (índices globais)
+            for(int i = 1; i < size; i += 2){
+                RandomStream rng = random_stream(base_seed, gen + 1, first + i);
+
+                int parent1 = tournament_selection_parallel(current, size, &rng);
+                int parent2 = tournament_selection_parallel(current, size, &rng);
 
-                // Aplica mutação no segundo filho gerado pelo cruzamento
-                // Preenche a nova população e reinicia o processo
-                if(i + 1 < POP_SIZE){
-                    mutate_parallel(&child2, &seed);
-                    new_population[i + 1] = child2;
+                crossover_parallel(current, parent1, parent2, next, i, i + 1, &rng);
+
+                evaluate_individual(next, i);
+                mutate_parallel(next, i, &rng);
+                local_search_parallel(next, i, &rng);
+                if(next->fitness[i] < next->fitness[current_best]){
+                    current_best = i;
+                }
+                if(i + 1 < size){
+                    evaluate_individual(next, i + 1);
+                    mutate_parallel(next, i + 1, &rng);
+                    local_search_parallel(next, i + 1, &rng);
+                    if(next->fitness[i + 1] < next->fitness[current_best]){
+                        current_best = i + 1;
+                    }
                 }
             }
+            phase_control[island] += t1 - t0;
+            phase_offspring[island] += omp_get_wtime() - t1;
         }
 
-        // Substitui a população antiga pela nova, reavaliando-a
-        // Distribui as atribuições entre as threads
-        #pragma omp parallel for schedule(static) num_threads(N_THREADS)
-        for(int i = 0; i < POP_SIZE; i++){
-            population[i] = new_population[i];
+        // Resultado da ilha: uma única seção crítica por thread ao final da execução
+        #pragma omp critical
+        {
+            if(best->fitness[0] < best_solution->fitness[0]){
+                copy_individual(best_solution, 0, best, 0);
+                generation = gen;
+            }
+            migrations_sent += sent;
+            migrations_dropped += dropped;
+            migrations_received += received;
         }
+        free_population(current);
+        free_population(next);
+        free_population(best);
+    }
+
+    for(int m = 0; m < n_threads * n_threads; m++){
+        free_population(mailboxes[m].migrants);
     }
+    free(mailboxes);
+    return generation;
+}
+
+// Função que gerencia o processamento principal
+// Trecho paralelo de interesse
+int main(int argc, char *argv[]){
+    int generation = 0;
+    int fixed_seed = 0;
+    int show_phases = 0;
+    struct timeval tv, start, stop;
+
+    // Tamanho do tabuleiro opcional na linha de comando (padrão N_QUEENS)
+    int i = 1;
+    if(argc > 1 && argv[1][0] != '-'){
+        n_queens = strtol(argv[1], NULL, 10);
+        if(n_queens < 1){
+            fprintf(stdout, "Valor de N inválido: %s\n", argv[1]);
+            return 1;
+        }
+        i++;
+    }
+
+    // Número de threads: -t, OMP_NUM_THREADS ou o padrão N_THREADS
+    if(getenv("OMP_NUM_THREADS") != NULL){
+        n_threads = omp_get_max_threads();
+    }
+
+    // Parâmetros do algoritmo após o tamanho do tabuleiro
+    for(; i < argc; i++){
+        if(strcmp(argv[i], "-p") == 0 && i + 1 < argc){
+            pop_size = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-g") == 0 && i + 1 < argc){
+            max_generations = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-m") == 0 && i + 1 < argc){
+            mutation_rate = strtod(argv[++i], NULL);
+        }
+        else if(strcmp(argv[i], "-k") == 0 && i + 1 < argc){
+            tournament_size = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-e") == 0 && i + 1 < argc){
+            stagnation_limit = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-l") == 0 && i + 1 < argc){
+            local_search_steps = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-f") == 0){
+            incremental_fitness = 0;
+        }
+        else if(strcmp(argv[i], "-x") == 0 && i + 1 < argc){
+            i++;
+            crossover_operator = -1;
+            for(int k = 0; k < (int)(sizeof(crossover_names) / sizeof(crossover_names[0])); k++){
+                if(strcmp(argv[i], crossover_names[k]) == 0){
+                    crossover_operator = k;
+                }
+            }
+        }
+        else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc){
+            base_seed = strtoull(argv[++i], NULL, 10);
+            fixed_seed = 1;
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc){
+            n_threads = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-d") == 0){
+            show_phases = 1;
+        }
+        else if(strcmp(argv[i], "-i") == 0 && i + 1 < argc){
+            migration_interval = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-n") == 0 && i + 1 < argc){
+            n_migrants = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc){
+            i++;
+            topology = -1;
+            for(int k = 0; k < (int)(sizeof(topology_names) / sizeof(topology_names[0])); k++){
+                if(strcmp(argv[i], topology_names[k]) == 0){
+                    topology = k;
+                }
+            }
+        }
+        else{
+            fprintf(stdout, "Opção desconhecida: %s\n", argv[i]);
+            fprintf(stdout, "Uso: %s [N] [-p população] [-g gerações] [-m mutação] [-k torneio] [-e estagnação] [-l busca local] [-f] [-x corte|ox|pmx|cx] [--seed semente] [-t threads] [-d] [-i intervalo [-n migrantes] [-r anel|aleatoria]]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(pop_size < 2 || max_generations < 1 || mutation_rate < 0.0 || mutation_rate > 1.0 ||
+       tournament_size < 1 || stagnation_limit < 1 || local_search_steps < 0 || crossover_operator < 0 || n_queens > UINT16_MAX || n_threads < 1 ||
+       migration_interval < 0 || topology < 0 || n_migrants < 1 ||
+       (migration_interval > 0 && n_migrants >= pop_size / n_threads)){
+        fprintf(stdout, "Parâmetros inválidos do algoritmo genético\n");
+        return 1;
+    }
+    gene_bytes = (n_queens <= 256) ? 1 : 2;
+    gene_stride = (n_queens * gene_bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    count_stride = (4 * n_queens - 2 + CACHE_LINE / sizeof(uint16_t) - 1) / (CACHE_LINE / sizeof(uint16_t)) * (CACHE_LINE / sizeof(uint16_t));
+    select_fitness();
+
+    gettimeofday(&tv, NULL);
+
+    // Semente aleatória com definição aprimorada (--seed fixa a semente para reproduzir a execução)
+    if(!fixed_seed){
+        base_seed = (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    }
+
+    // Populações no heap, alocadas uma única vez para toda a execução
+    // As duas se alternam a cada geração; a posição extra recebe o segundo filho descartado quando pop_size é par
+    Population *population = allocate_population(pop_size + 1);
+    Population *new_population = allocate_population(pop_size + 1);
+    Population *best_solution = allocate_population(1);
+    crossover_work = allocate_crossover_work(n_threads);
+    fitness_counts = allocate_fitness_counts(n_threads);
+    phase_control = (double *)calloc(n_threads, sizeof(double));
+    phase_offspring = (double *)calloc(n_threads, sizeof(double));
+    phase_wait = (double *)calloc(n_threads, sizeof(double));
+    best_solution->fitness[0] = n_queens * n_queens;
+
+    // Inicializa valores das primeiras populações
+    initialize_population_parallel(population);
+
+    // Obtém o tempo inicial
+    gettimeofday(&start, NULL);
+
+    // Evolui a população global ou as ilhas
+    if(migration_interval > 0){
+        generation = evolve_islands(population, best_solution);
+    }
+    else{
+        generation = evolve_population(population, new_population, best_solution);
+    }
+
+    // Obtém o tempo final (também quando o limite de gerações é atingido)
+    gettimeofday(&stop, NULL);
+
     // Cálculo do tempo gasto pelo processo
     double t = (double)(stop.tv_sec - start.tv_sec) * 1000.0 + (double)(stop.tv_usec - start.tv_usec) / 1000.0;
 
     // Confirma se houve solução encontrada ou não
-    if(best_solution.fitness == 0){
+    if(best_solution->fitness[0] == 0){
         printf("Solucao na Geracao %d!\n", generation);
         fprintf(stdout, "Tempo decorrido = %g ms\n", t);
     }else{
-        printf("Não foi possível encontrar solução otima. Melhor fitness: %d\n", best_solution.fitness);
+        printf("Não foi possível encontrar solução otima. Melhor fitness: %d\n", best_solution->fitness[0]);
     }
+    printf("Semente: %llu\n", (unsigned long long)base_seed);
+
+    // Tempo médio por thread em cada fase (o controle inclui a espera pela thread do single)
+    if(show_phases){
+        double control = 0.0, offspring = 0.0, wait = 0.0;
+        for(int t = 0; t < n_threads; t++){
+            control += phase_control[t];
+            offspring += phase_offspring[t];
+            wait += phase_wait[t];
+        }
+        fprintf(stdout, "Fases em %d gerações, média por thread (ms): controle = %g, descendentes = %g, espera = %g\n",
+                generation, 1000.0 * control / n_threads, 1000.0 * offspring / n_threads, 1000.0 * wait / n_threads);
+        if(migration_interval > 0){
+            fprintf(stdout, "Migrações: enviadas = %lld, descartadas (caixa cheia) = %lld, recebidas = %lld\n",
+                    migrations_sent, migrations_dropped, migrations_received);
+        }
+    }
+    free(phase_control);
+    free(phase_offspring);
+    free(phase_wait);
 
     // Imprime o tabuleiro para confirmação visual
-    //print_solution(best_solution);
+    //print_solution(best_solution, 0);
+
+    free_population(population);
+    free_population(new_population);
+    free_population(best_solution);
+    free_crossover_work(crossover_work, n_threads);
+    free(fitness_counts);
 
     return 0;
 }
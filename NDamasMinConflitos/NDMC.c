@@ -0,0 +1,366 @@
+// Busca Local por Mínimos Conflitos
+// Tenta resolver o Problema das N-Damas
+// Abordagem sequencial que busca uma solução válida (decisão) para valores muito grandes de N
+// Mesma representação do algoritmo genético: uma dama por coluna e as linhas formando uma permutação,
+// de modo que só as diagonais podem ter conflitos
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+// Parâmetros de execução dos experimentos
+#define N_QUEENS 1000000 // Tamanho padrão do tabuleiro (alterado pelo primeiro argumento)
+#define CANDIDATES 64 // Trocas avaliadas por dama em conflito (-c); com N <= CANDIDATES todas são avaliadas
+#define RANDOM_TAIL 32 // Últimas colunas da inicialização posicionadas sem a restrição gulosa
+#define SWAPS_PER_QUEEN 20 // Limite padrão de trocas por dama antes de reiniciar (-l)
+#define MAX_RESTARTS 100 // Número máximo padrão de reinícios (-r)
+
+// Tamanho do tabuleiro e parâmetros da busca definidos na linha de comando
+static int n_queens = N_QUEENS;
+static int candidates = CANDIDATES;
+static long long max_swaps;
+static int max_restarts = MAX_RESTARTS;
+static uint64_t base_seed; // Semente da execução (--seed ou relógio)
+
+// Estado da busca: linha da dama em cada coluna e damas por diagonal
+// Memória O(N): 4 bytes por coluna e 4 bytes por diagonal (2N-1 principais e 2N-1 secundárias)
+static uint32_t *rows;
+static uint32_t *d1_counts; // Diagonais principais (coluna - linha + N - 1)
+static uint32_t *d2_counts; // Diagonais secundárias (coluna + linha)
+static long long conflicts; // Conflitos atuais, na mesma medida da aptidão do algoritmo genético
+
+// Gerador pseudoaleatório baseado em contador (SplitMix64), o mesmo do algoritmo genético
+typedef struct{
+    uint64_t counter; // Contador do fluxo, avançado a cada sorteio
+} RandomStream;
+
+// Função de mistura do SplitMix64 (bijeção de 64 bits)
+uint64_t mix64(uint64_t z){
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Função que cria o fluxo de uma tentativa (uma por reinício)
+RandomStream random_stream(uint64_t seed, uint32_t attempt, uint32_t index){
+    RandomStream rng;
+    rng.counter = mix64(seed ^ mix64(((uint64_t)attempt << 32) | index));
+    return rng;
+}
+
+// Função que gera o próximo valor de 64 bits do fluxo
+uint64_t random_next(RandomStream *rng){
+    return mix64(rng->counter += 0x9E3779B97F4A7C15ULL);
+}
+
+// Função para gerar valores inteiros aleatórios em [0, max) sem viés
+// Multiplicação de Lemire: rejeita apenas a fração residual de 2^32 que não divide max
+int get_random_int(RandomStream *rng, int max){
+    uint64_t m = (random_next(rng) >> 32) * (uint64_t)max;
+
+    if((uint32_t)m < (uint32_t)max){
+        uint32_t threshold = -(uint32_t)max % (uint32_t)max;
+        while((uint32_t)m < threshold){
+            m = (random_next(rng) >> 32) * (uint64_t)max;
+        }
+    }
+    return (int)(m >> 32);
+}
+
+// Função que calcula a aptidão (conflitos) de uma permutação do zero, com contadores próprios
+// Mesma medida do calculate_fitness do algoritmo genético; confere o estado incremental ao final
+long long calculate_fitness(const uint32_t *genome){
+    uint32_t *d1 = (uint32_t *)calloc(2 * n_queens - 1, sizeof(uint32_t));
+    uint32_t *d2 = (uint32_t *)calloc(2 * n_queens - 1, sizeof(uint32_t));
+    uint8_t *used = (uint8_t *)calloc(n_queens, sizeof(uint8_t));
+    long long total = 0;
+
+    if(d1 == NULL || d2 == NULL || used == NULL){
+        fprintf(stdout, "Memória insuficiente para a verificação (N=%d)\n", n_queens);
+        exit(1);
+    }
+    for(int col = 0; col < n_queens; col++){
+        uint32_t row = genome[col];
+
+        // Uma linha fora do tabuleiro ou repetida invalida a permutação
+        if(row >= (uint32_t)n_queens || used[row]){
+            total = -1;
+            break;
+        }
+        used[row] = 1;
+        total += (d1[col - row + (n_queens - 1)]++ > 0);
+        total += (d2[col + row]++ > 0);
+    }
+    free(d1);
+    free(d2);
+    free(used);
+    return total;
+}
+
+// Função que coloca a dama da coluna na linha e devolve os conflitos criados
+int place_queen(int col, uint32_t row){
+    rows[col] = row;
+    return (d1_counts[col - row + (n_queens - 1)]++ > 0) + (d2_counts[col + row]++ > 0);
+}
+
+// Função que retira a dama da coluna e devolve os conflitos desfeitos
+int remove_queen(int col){
+    uint32_t row = rows[col];
+    return (--d1_counts[col - row + (n_queens - 1)] > 0) + (--d2_counts[col + row] > 0);
+}
+
+// Função que troca as linhas das damas de duas colunas e devolve a variação dos conflitos em O(1)
+// Trocar de novo as mesmas colunas desfaz a operação
+int swap_queens(int col1, int col2){
+    uint32_t row1 = rows[col1], row2 = rows[col2];
+    int delta = -remove_queen(col1) - remove_queen(col2);
+
+    delta += place_queen(col1, row2) + place_queen(col2, row1);
+    conflicts += delta;
+    return delta;
+}
+
+// Função que informa se a dama da coluna divide alguma diagonal
+int is_conflicted(int col){
+    uint32_t row = rows[col];
+    return d1_counts[col - row + (n_queens - 1)] > 1 || d2_counts[col + row] > 1;
+}
+
+// Função que gera a permutação inicial gulosa (Sosič e Gu)
+// Cada coluna sorteia entre as linhas ainda livres até achar uma sem conflito nas diagonais,
+// com no máximo N - col tentativas; as últimas RANDOM_TAIL colunas recebem linhas livres quaisquer
+void initialize_greedy(RandomStream *rng){
+    int tail = (n_queens < RANDOM_TAIL) ? n_queens : RANDOM_TAIL;
+
+    memset(d1_counts, 0, (2 * n_queens - 1) * sizeof(uint32_t));
+    memset(d2_counts, 0, (2 * n_queens - 1) * sizeof(uint32_t));
+    for(int col = 0; col < n_queens; col++){
+        rows[col] = col;
+    }
+    conflicts = 0;
+
+    // As linhas livres ficam nas posições [col, N) de rows, como no Fisher-Yates
+    for(int col = 0; col < n_queens; col++){
+        int free_rows = n_queens - col;
+        int k = col + get_random_int(rng, free_rows);
+
+        if(col < n_queens - tail){
+            for(int tries = 1; tries < free_rows; tries++){
+                uint32_t row = rows[k];
+                if(d1_counts[col - row + (n_queens - 1)] == 0 && d2_counts[col + row] == 0){
+                    break;
+                }
+                k = col + get_random_int(rng, free_rows);
+            }
+        }
+        uint32_t row = rows[k];
+        rows[k] = rows[col];
+        conflicts += place_queen(col, row);
+    }
+}
+
+// Função que leva uma dama em conflito para a linha de menor conflito entre as candidatas
+// A linha é trocada com a de outra coluna, preservando a permutação
+// Com N <= candidates todas as colunas são avaliadas; senão, candidates colunas sorteadas
+// Empates são aceitos (movimento lateral) para atravessar platôs; devolve 1 se houve troca
+int repair_queen(int col, RandomStream *rng){
+    int best_col = -1, best_delta = 0, ties = 0;
+    int full_scan = (n_queens <= candidates);
+    int count = full_scan ? n_queens : candidates;
+
+    for(int c = 0; c < count; c++){
+        int other = full_scan ? c : get_random_int(rng, n_queens);
+        if(other == col){
+            continue;
+        }
+
+        // Avalia a troca aplicando-a e desfazendo em seguida (ambas O(1))
+        int delta = swap_queens(col, other);
+        swap_queens(col, other);
+
+        // Entre variações iguais, escolhe uniformemente (amostragem de reservatório)
+        if(best_col < 0 || delta < best_delta){
+            best_col = other;
+            best_delta = delta;
+            ties = 1;
+        }
+        else if(delta == best_delta && get_random_int(rng, ++ties) == 0){
+            best_col = other;
+        }
+    }
+    if(best_col < 0 || best_delta > 0){
+        return 0;
+    }
+    swap_queens(col, best_col);
+    return 1;
+}
+
+// Função que repara a permutação por varreduras das colunas em conflito
+// Devolve o número de trocas feitas; para ao zerar os conflitos ou após max_swaps tentativas
+// (aceitas ou não), e também quando uma varredura completa não move nenhuma dama: com todas
+// as colunas avaliadas isso é um mínimo local estrito e só um reinício sai dele
+long long repair(RandomStream *rng){
+    long long swaps = 0, attempts = 0;
+    int full_scan = (n_queens <= candidates);
+
+    while(conflicts > 0 && attempts < max_swaps){
+        long long before = swaps;
+        for(int col = 0; col < n_queens && conflicts > 0 && attempts < max_swaps; col++){
+            if(is_conflicted(col)){
+                swaps += repair_queen(col, rng);
+                attempts++;
+            }
+        }
+        if(full_scan && swaps == before){
+            break;
+        }
+    }
+    return swaps;
+}
+
+// Função que devolve o tempo decorrido entre dois instantes em ms
+double elapsed_ms(const struct timeval *from, const struct timeval *to){
+    return (double)(to->tv_sec - from->tv_sec) * 1000.0 + (double)(to->tv_usec - from->tv_usec) / 1000.0;
+}
+
+// Função para mostrar o tabuleiro para validação
+void print_solution(){
+    printf("\nSolucao encontrada para N=%d)\n", n_queens);
+    if(n_queens <= 16){
+        for(int i = 0; i < n_queens; i++){
+            for(int j = 0; j < n_queens; j++){
+                printf("%d ", rows[i] == (uint32_t)j ? 1 : 0);
+            }
+            printf("\n");
+        }
+    }
+    else{
+        for(int i = 0; i < n_queens; i++){
+            printf("(%d, %u) ", i, rows[i]);
+        }
+        printf("\n");
+    }
+}
+
+// Função que gerencia o processamento principal
+int main(int argc, char *argv[]){
+    int fixed_seed = 0;
+    int show_details = 0;
+    int show_board = 0;
+    long long swaps_per_queen = SWAPS_PER_QUEEN;
+    long long swaps = 0, initial_conflicts = 0;
+    double init_ms = 0.0;
+    int attempt;
+    struct timeval tv, start, stop, phase_start, phase_stop;
+
+    // Tamanho do tabuleiro opcional na linha de comando (padrão N_QUEENS)
+    int i = 1;
+    if(argc > 1 && argv[1][0] != '-'){
+        n_queens = strtol(argv[1], NULL, 10);
+        if(n_queens < 1){
+            fprintf(stdout, "Valor de N inválido: %s\n", argv[1]);
+            return 1;
+        }
+        i = 2;
+    }
+
+    // Parâmetros da busca após o tamanho do tabuleiro
+    for(; i < argc; i++){
+        if(strcmp(argv[i], "-c") == 0 && i + 1 < argc){
+            candidates = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-l") == 0 && i + 1 < argc){
+            swaps_per_queen = strtoll(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc){
+            max_restarts = strtol(argv[++i], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc){
+            base_seed = strtoull(argv[++i], NULL, 10);
+            fixed_seed = 1;
+        }
+        else if(strcmp(argv[i], "-d") == 0){
+            show_details = 1;
+        }
+        else if(strcmp(argv[i], "-s") == 0){
+            show_board = 1;
+        }
+        else{
+            fprintf(stdout, "Opção desconhecida: %s\n", argv[i]);
+            fprintf(stdout, "Uso: %s [N] [-c candidatos] [-l trocas por dama] [-r reinícios] [--seed semente] [-d] [-s]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(candidates < 1 || swaps_per_queen < 1 || max_restarts < 0 || n_queens > INT32_MAX / 2){
+        fprintf(stdout, "Parâmetros inválidos da busca por mínimos conflitos\n");
+        return 1;
+    }
+    max_swaps = swaps_per_queen * n_queens;
+
+    gettimeofday(&tv, NULL);
+
+    // Semente aleatória com definição aprimorada (--seed fixa a semente para reproduzir a execução)
+    if(!fixed_seed){
+        base_seed = (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    }
+
+    // Estado da busca no heap, alocado uma única vez
+    rows = (uint32_t *)malloc(n_queens * sizeof(uint32_t));
+    d1_counts = (uint32_t *)malloc((2 * n_queens - 1) * sizeof(uint32_t));
+    d2_counts = (uint32_t *)malloc((2 * n_queens - 1) * sizeof(uint32_t));
+    if(rows == NULL || d1_counts == NULL || d2_counts == NULL){
+        fprintf(stdout, "Memória insuficiente para o tabuleiro (N=%d)\n", n_queens);
+        return 1;
+    }
+
+    // Obtém o tempo inicial (a inicialização gulosa faz parte da busca)
+    gettimeofday(&start, NULL);
+
+    // Cada tentativa parte de uma nova permutação gulosa com o próprio fluxo aleatório
+    for(attempt = 0; attempt <= max_restarts; attempt++){
+        RandomStream rng = random_stream(base_seed, attempt, 0);
+
+        gettimeofday(&phase_start, NULL);
+        initialize_greedy(&rng);
+        gettimeofday(&phase_stop, NULL);
+        init_ms += elapsed_ms(&phase_start, &phase_stop);
+        initial_conflicts = conflicts;
+
+        swaps += repair(&rng);
+        if(conflicts == 0){
+            break;
+        }
+    }
+
+    // Obtém o tempo final
+    gettimeofday(&stop, NULL);
+
+    // Cálculo do tempo gasto pelo processo
+    double t = elapsed_ms(&start, &stop);
+
+    // Confirma se houve solução encontrada ou não, conferindo a permutação do zero
+    if(conflicts == 0 && calculate_fitness(rows) == 0){
+        printf("Solucao com %lld trocas!\n", swaps);
+        fprintf(stdout, "Tempo decorrido = %g ms\n", t);
+    }else{
+        printf("Não foi possível encontrar solução otima. Conflitos restantes: %lld\n", conflicts);
+    }
+    printf("Semente: %llu\n", (unsigned long long)base_seed);
+
+    if(show_details){
+        fprintf(stdout, "Detalhes: %d reinício(s), %lld conflitos após a inicialização gulosa, inicialização = %g ms\n",
+                attempt > max_restarts ? max_restarts : attempt, initial_conflicts, init_ms);
+    }
+
+    // Imprime o tabuleiro para confirmação visual
+    if(show_board && conflicts == 0){
+        print_solution();
+    }
+
+    free(rows);
+    free(d1_counts);
+    free(d2_counts);
+
+    return 0;
+}